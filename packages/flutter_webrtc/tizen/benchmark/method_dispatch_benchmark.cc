@@ -0,0 +1,193 @@
+// A micro-benchmark of the method call dispatch and argument parsing of
+// FlutterWebRTC::HandleMethodCall. It is not part of the plugin build.
+//
+// Build and run on the host with the Flutter C++ client wrapper headers, e.g.:
+//
+//   g++ -std=c++17 -O2 -I../inc -I<client_wrapper>/include
+//       -I<flutter_tizen>/shell/platform/common/public
+//       method_dispatch_benchmark.cc -o method_dispatch_benchmark
+//   ./method_dispatch_benchmark
+
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+#include "flutter_common.h"
+
+namespace {
+
+// The method names in the order of the if-else chain that
+// HandleMethodCall walked before the hash table was introduced.
+const char* const kFormerChain[] = {
+    "initialize",
+    "createPeerConnection",
+    "getUserMedia",
+    "getDisplayMedia",
+    "getDesktopSources",
+    "updateDesktopSources",
+    "getDesktopSourceThumbnail",
+    "getSources",
+    "selectAudioInput",
+    "selectAudioOutput",
+    "mediaStreamGetTracks",
+    "createOffer",
+    "createAnswer",
+    "addStream",
+    "removeStream",
+    "setLocalDescription",
+    "setRemoteDescription",
+    "addCandidate",
+    "getStats",
+    "createDataChannel",
+    "dataChannelSend",
+    "dataChannelClose",
+    "streamDispose",
+    "mediaStreamTrackSetEnable",
+    "trackDispose",
+    "restartIce",
+    "peerConnectionClose",
+    "peerConnectionDispose",
+    "createVideoRenderer",
+    "videoRendererDispose",
+    "videoRendererSetSrcObject",
+    "mediaStreamTrackSwitchCamera",
+    "setVolume",
+    "getLocalDescription",
+    "getRemoteDescription",
+    "mediaStreamAddTrack",
+    "mediaStreamRemoveTrack",
+    "addTrack",
+    "removeTrack",
+    "addTransceiver",
+    "getTransceivers",
+    "getReceivers",
+    "getSenders",
+    "rtpSenderSetTrack",
+    "rtpSenderSetStreams",
+    "rtpSenderReplaceTrack",
+    "rtpSenderSetParameters",
+    "rtpTransceiverStop",
+    "rtpTransceiverGetCurrentDirection",
+    "rtpTransceiverSetDirection",
+    "setConfiguration",
+    "captureFrame",
+    "createLocalMediaStream",
+    "canInsertDtmf",
+    "sendDtmf",
+    "getRtpSenderCapabilities",
+    "getRtpReceiverCapabilities",
+    "setCodecPreferences",
+    "getSignalingState",
+    "getIceGatheringState",
+    "getIceConnectionState",
+    "getConnectionState"};
+
+constexpr int kIterations = 1000000;
+
+// Prevents the compiler from optimizing the measured work away.
+volatile size_t sink = 0;
+
+template <typename Function>
+void Measure(const char* name, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    function();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  double ns =
+      std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+  printf("%-40s %8.1f ns/call\n", name, ns);
+}
+
+// The former helpers, which took their values by value and returned copies.
+template <typename T>
+inline bool LegacyTypeIs(const EncodableValue val) {
+  return std::holds_alternative<T>(val);
+}
+
+template <typename T>
+inline const T LegacyGetValue(EncodableValue val) {
+  return std::get<T>(val);
+}
+
+EncodableMap LegacyFindMap(const EncodableMap& map, const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end() && LegacyTypeIs<EncodableMap>(it->second))
+    return LegacyGetValue<EncodableMap>(it->second);
+  return EncodableMap();
+}
+
+std::string LegacyFindString(const EncodableMap& map, const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end() && LegacyTypeIs<std::string>(it->second))
+    return LegacyGetValue<std::string>(it->second);
+  return std::string();
+}
+
+int64_t LegacyFindLongInt(const EncodableMap& map, const std::string& key) {
+  for (auto it : map) {
+    if (key == LegacyGetValue<std::string>(it.first)) {
+      if (LegacyTypeIs<int64_t>(it.second)) {
+        return LegacyGetValue<int64_t>(it.second);
+      } else if (LegacyTypeIs<int32_t>(it.second)) {
+        return LegacyGetValue<int32_t>(it.second);
+      }
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+int main() {
+  std::unordered_map<std::string, size_t> table;
+  for (size_t i = 0; i < std::size(kFormerChain); i++) {
+    table[kFormerChain[i]] = i;
+  }
+
+  for (const char* method : {"addCandidate", "getStats", "dataChannelSend",
+                             "getConnectionState"}) {
+    std::string method_name = method;
+    printf("%s\n", method);
+    Measure("  if-else chain", [&] {
+      for (size_t i = 0; i < std::size(kFormerChain); i++) {
+        if (method_name.compare(kFormerChain[i]) == 0) {
+          sink = i;
+          break;
+        }
+      }
+    });
+    Measure("  hash table", [&] { sink = table.find(method_name)->second; });
+  }
+
+  EncodableMap candidate = {
+      {EncodableValue("candidate"),
+       EncodableValue("candidate:1 1 udp 2122260223 192.168.0.2 54321 typ "
+                      "host generation 0 ufrag abcd network-id 1")},
+      {EncodableValue("sdpMid"), EncodableValue("0")},
+      {EncodableValue("sdpMLineIndex"), EncodableValue(0)},
+  };
+  EncodableValue arguments(EncodableMap{
+      {EncodableValue("peerConnectionId"),
+       EncodableValue("d1b4c3a2-0f6e-4e7a-9a3b-7c2d1e0f9a8b")},
+      {EncodableValue("candidate"), EncodableValue(candidate)},
+      {EncodableValue("timeout"), EncodableValue(int64_t(1000))},
+  });
+
+  printf("addCandidate arguments\n");
+  Measure("  copying helpers", [&] {
+    const EncodableMap params = LegacyGetValue<EncodableMap>(arguments);
+    const std::string id = LegacyFindString(params, "peerConnectionId");
+    const EncodableMap map = LegacyFindMap(params, "candidate");
+    sink = id.size() + map.size() + LegacyFindLongInt(params, "timeout");
+  });
+  Measure("  reference helpers", [&] {
+    const EncodableMap& params = GetValue<EncodableMap>(arguments);
+    const std::string id = findString(params, "peerConnectionId");
+    const EncodableMap& map = findMap(params, "candidate");
+    sink = id.size() + map.size() + findLongInt(params, "timeout");
+  });
+  return 0;
+}
@@ -30,12 +30,12 @@ typedef flutter::MethodResult<EncodableValue> MethodResult;
 // foo.IsString() becomes std::holds_alternative<std::string>(foo)
 
 template <typename T>
-inline bool TypeIs(const EncodableValue val) {
+inline bool TypeIs(const EncodableValue& val) {
   return std::holds_alternative<T>(val);
 }
 
 template <typename T>
-inline const T GetValue(EncodableValue val) {
+inline const T& GetValue(const EncodableValue& val) {
   return std::get<T>(val);
 }
 
@@ -46,18 +46,24 @@ inline EncodableValue findEncodableValue(const EncodableMap& map,
   return EncodableValue();
 }
 
-inline EncodableMap findMap(const EncodableMap& map, const std::string& key) {
+// Returns a reference into |map|, or to an empty map if |key| is not a map.
+inline const EncodableMap& findMap(const EncodableMap& map,
+                                   const std::string& key) {
+  static const EncodableMap empty;
   auto it = map.find(EncodableValue(key));
   if (it != map.end() && TypeIs<EncodableMap>(it->second))
     return GetValue<EncodableMap>(it->second);
-  return EncodableMap();
+  return empty;
 }
 
-inline EncodableList findList(const EncodableMap& map, const std::string& key) {
+// Returns a reference into |map|, or to an empty list if |key| is not a list.
+inline const EncodableList& findList(const EncodableMap& map,
+                                     const std::string& key) {
+  static const EncodableList empty;
   auto it = map.find(EncodableValue(key));
   if (it != map.end() && TypeIs<EncodableList>(it->second))
     return GetValue<EncodableList>(it->second);
-  return EncodableList();
+  return empty;
 }
 
 inline std::string findString(const EncodableMap& map, const std::string& key) {
@@ -97,16 +103,14 @@ inline std::vector<uint8_t> findVector(const EncodableMap& map,
 }
 
 inline int64_t findLongInt(const EncodableMap& map, const std::string& key) {
-  for (auto it : map) {
-    if (key == GetValue<std::string>(it.first)) {
-      if (TypeIs<int64_t>(it.second)) {
-        return GetValue<int64_t>(it.second);
-      } else if (TypeIs<int32_t>(it.second)) {
-        return GetValue<int32_t>(it.second);
-      }
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end()) {
+    if (TypeIs<int64_t>(it->second)) {
+      return GetValue<int64_t>(it->second);
+    } else if (TypeIs<int32_t>(it->second)) {
+      return GetValue<int32_t>(it->second);
     }
   }
-
   return -1;
 }
 
@@ -167,6 +171,7 @@ class EventChannelProxy {
 
   virtual void Success(const EncodableValue& event,
                        bool cache_event = true) = 0;
+  virtual void Success(EncodableValue&& event, bool cache_event = true) = 0;
 };
 
 #endif  // FLUTTER_WEBRTC_COMMON_HXX
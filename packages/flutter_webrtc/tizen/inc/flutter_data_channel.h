@@ -1,6 +1,12 @@
 #ifndef FLUTTER_WEBRTC_RTC_DATA_CHANNEL_HXX
 #define FLUTTER_WEBRTC_RTC_DATA_CHANNEL_HXX
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "flutter_common.h"
 #include "flutter_webrtc_base.h"
 
@@ -17,11 +23,48 @@ class FlutterRTCDataChannelObserver : public RTCDataChannelObserver {
 
   virtual void OnMessage(const char* buffer, int length, bool binary) override;
 
+  // Queues |size| bytes of |data| to be sent on a worker thread, so that the
+  // platform thread is never blocked by a congested channel.
+  void Send(const uint8_t* data, size_t size, bool binary);
+
+  // The number of bytes queued by Send() that haven't been handed to the data
+  // channel yet. The libwebrtc wrapper doesn't expose the amount buffered by
+  // the channel itself, so that isn't included.
+  uint64_t buffered_amount();
+
+  // A dataChannelBufferedAmountChange event is sent whenever the buffered
+  // amount crosses this threshold in either direction.
+  void set_buffered_amount_low_threshold(uint64_t threshold);
+
   scoped_refptr<RTCDataChannel> data_channel() { return data_channel_; }
 
  private:
+  struct Message {
+    std::vector<uint8_t> data;
+    bool binary;
+  };
+
+  void RunSender();
+  // Returns true if |amount| is on the other side of the threshold than the
+  // last reported amount, and sets |changed_amount| to the difference. Must
+  // be called with |send_mutex_| held.
+  bool CrossesThreshold(uint64_t amount, int64_t* changed_amount);
+  void NotifyBufferedAmountChange(uint64_t buffered_amount,
+                                  int64_t changed_amount);
+
   std::unique_ptr<EventChannelProxy> event_channel_;
   scoped_refptr<RTCDataChannel> data_channel_;
+
+  std::mutex send_mutex_;
+  std::condition_variable send_cond_;
+  std::deque<Message> send_queue_;
+  // The number of bytes in |send_queue_| and being sent by the worker.
+  uint64_t queued_amount_ = 0;
+  uint64_t buffered_amount_low_threshold_ = 0;
+  bool above_threshold_ = false;
+  uint64_t last_reported_amount_ = 0;
+  bool stopped_ = false;
+  std::thread sender_;
 };
 
 class FlutterDataChannel {
@@ -34,16 +77,26 @@ class FlutterDataChannel {
                          RTCPeerConnection* pc,
                          std::unique_ptr<MethodResultProxy>);
 
-  void DataChannelSend(RTCDataChannel* data_channel, const std::string& type,
-                       const EncodableValue& data,
+  void DataChannelSend(FlutterRTCDataChannelObserver* observer,
+                       const std::string& type, const EncodableValue& data,
                        std::unique_ptr<MethodResultProxy>);
 
+  void DataChannelGetBufferedAmount(FlutterRTCDataChannelObserver* observer,
+                                    std::unique_ptr<MethodResultProxy>);
+
+  void DataChannelSetBufferedAmountLowThreshold(
+      FlutterRTCDataChannelObserver* observer, int64_t threshold,
+      std::unique_ptr<MethodResultProxy>);
+
   void DataChannelClose(RTCDataChannel* data_channel,
                         const std::string& data_channel_uuid,
                         std::unique_ptr<MethodResultProxy>);
 
   RTCDataChannel* DataChannelForId(const std::string& id);
 
+  FlutterRTCDataChannelObserver* DataChannelObserverForId(
+      const std::string& id);
+
  private:
   FlutterWebRTCBase* base_;
 };
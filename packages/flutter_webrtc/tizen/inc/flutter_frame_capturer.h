@@ -0,0 +1,58 @@
+#ifndef FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
+#define FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
+
+#include <Ecore.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "flutter_common.h"
+#include "flutter_webrtc_base.h"
+#include "rtc_video_frame.h"
+#include "rtc_video_renderer.h"
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Saves the next frame of a video track to a JPEG or PNG file.
+//
+// The capturer attaches itself to the track as a one-shot renderer. The frame
+// is converted and encoded on a worker thread, so neither the WebRTC threads
+// nor the platform thread are blocked. The result is replied on the platform
+// thread.
+class FlutterFrameCapturer
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>>,
+      public RefCountInterface {
+ public:
+  FlutterFrameCapturer(RTCVideoTrack* track, std::string path);
+
+  // Must be called on the platform thread.
+  void CaptureFrame(std::unique_ptr<MethodResultProxy> result);
+
+  virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
+
+ protected:
+  ~FlutterFrameCapturer();
+
+ private:
+  // Runs on a worker thread.
+  void SaveFrame(scoped_refptr<RTCVideoFrame> frame);
+  // Runs on the platform thread.
+  void Complete(bool success, const std::string& error_message);
+
+  // Posts Complete() to the platform thread.
+  void PostComplete(bool success, const std::string& error_message);
+
+  scoped_refptr<RTCVideoTrack> track_;
+  std::string path_;
+  std::unique_ptr<MethodResultProxy> result_;
+  Ecore_Timer* timeout_timer_ = nullptr;
+  // Set by whichever of the first frame or the timeout comes first.
+  std::atomic<bool> catch_frame_ = false;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
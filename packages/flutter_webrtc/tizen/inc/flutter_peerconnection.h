@@ -86,6 +86,9 @@ class FlutterPeerConnection {
   libwebrtc::scoped_refptr<libwebrtc::RTCRtpEncodingParameters> mapToEncoding(
       const EncodableMap& parameters);
 
+  void applyEncoding(const EncodableMap& parameters,
+                     scoped_refptr<RTCRtpEncodingParameters> encoding);
+
   void AddTransceiver(RTCPeerConnection* pc, const std::string& trackId,
                       const std::string& mediaType,
                       const EncodableMap& transceiverInit,
@@ -111,7 +114,8 @@ class FlutterPeerConnection {
                              std::unique_ptr<MethodResultProxy> result);
 
   scoped_refptr<RTCRtpParameters> updateRtpParameters(
-      EncodableMap newParameters, scoped_refptr<RTCRtpParameters> parameters);
+      const EncodableMap& newParameters,
+      scoped_refptr<RTCRtpParameters> parameters);
 
   void RtpSenderSetParameters(RTCPeerConnection* pc, std::string rtpSenderId,
                               const EncodableMap& parameters,
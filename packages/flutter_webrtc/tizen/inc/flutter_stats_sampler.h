@@ -0,0 +1,121 @@
+#ifndef FLUTTER_WEBRTC_RTC_STATS_SAMPLER_HXX
+#define FLUTTER_WEBRTC_RTC_STATS_SAMPLER_HXX
+
+#include <Ecore.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "flutter_common.h"
+#include "flutter_webrtc_base.h"
+
+namespace flutter_webrtc_plugin {
+
+// Periodically samples the stats of a peer connection and reports only the
+// selected metrics, computed as deltas between consecutive samples, on the
+// "FlutterWebRTC/statsEvent<peerConnectionId>" event channel.
+class FlutterStatsSampler
+    : public std::enable_shared_from_this<FlutterStatsSampler> {
+ public:
+  FlutterStatsSampler(scoped_refptr<RTCPeerConnection> pc,
+                      BinaryMessenger* messenger,
+                      const std::string& peer_connection_id,
+                      std::set<std::string> metrics);
+  ~FlutterStatsSampler();
+
+  // Must be called on the platform thread.
+  bool Start(int64_t interval_ms);
+  // Must be called on the platform thread.
+  void Stop();
+
+ private:
+  // The cumulative counters of an RTP stream at a point in time.
+  struct RtpSample {
+    int64_t timestamp_us = 0;
+    double bytes = 0;
+    double frames = 0;
+    double packets = 0;
+    double packets_lost = 0;
+  };
+
+  void Sample();
+  // Called on the platform thread.
+  void OnStats(const vector<scoped_refptr<MediaRTCStats>>& reports);
+  bool IsSelected(const std::string& metric) const {
+    return metrics_.empty() || metrics_.count(metric) > 0;
+  }
+
+  scoped_refptr<RTCPeerConnection> pc_;
+  std::unique_ptr<EventChannelProxy> event_channel_;
+  std::set<std::string> metrics_;
+  Ecore_Timer* timer_ = nullptr;
+
+  std::map<std::string, RtpSample> last_samples_;
+};
+
+// Periodically reports the audio level of a track attached to a peer
+// connection on the "FlutterWebRTC/audioLevelEvent<trackId>" event channel.
+//
+// The levels are computed natively from the audio energy counters of the
+// track's stats, so no audio samples cross the platform channel.
+class FlutterAudioLevelMonitor
+    : public std::enable_shared_from_this<FlutterAudioLevelMonitor> {
+ public:
+  FlutterAudioLevelMonitor(scoped_refptr<RTCPeerConnection> pc,
+                           scoped_refptr<RTCRtpSender> sender,
+                           scoped_refptr<RTCRtpReceiver> receiver,
+                           BinaryMessenger* messenger,
+                           const std::string& peer_connection_id,
+                           const std::string& track_id);
+  ~FlutterAudioLevelMonitor();
+
+  // Must be called on the platform thread.
+  bool Start(int64_t interval_ms);
+  // Must be called on the platform thread.
+  void Stop();
+
+  const std::string& peer_connection_id() const { return peer_connection_id_; }
+
+ private:
+  void Sample();
+  // Called on the platform thread.
+  void OnStats(const vector<scoped_refptr<MediaRTCStats>>& reports);
+
+  scoped_refptr<RTCPeerConnection> pc_;
+  scoped_refptr<RTCRtpSender> sender_;
+  scoped_refptr<RTCRtpReceiver> receiver_;
+  std::unique_ptr<EventChannelProxy> event_channel_;
+  std::string peer_connection_id_;
+  std::string track_id_;
+  Ecore_Timer* timer_ = nullptr;
+
+  // The last total audio energy and duration, or negative if not sampled.
+  double last_energy_ = -1;
+  double last_duration_ = -1;
+};
+
+class FlutterStatsSampling {
+ public:
+  FlutterStatsSampling(FlutterWebRTCBase* base) : base_(base) {}
+
+  void StartStatsSampling(const EncodableMap& params,
+                          std::unique_ptr<MethodResultProxy> result);
+
+  void StopStatsSampling(const EncodableMap& params,
+                         std::unique_ptr<MethodResultProxy> result);
+
+  void StartAudioLevelMonitor(const EncodableMap& params,
+                              std::unique_ptr<MethodResultProxy> result);
+
+  void StopAudioLevelMonitor(const EncodableMap& params,
+                             std::unique_ptr<MethodResultProxy> result);
+
+ private:
+  FlutterWebRTCBase* base_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_STATS_SAMPLER_HXX
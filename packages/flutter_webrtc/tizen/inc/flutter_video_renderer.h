@@ -1,7 +1,13 @@
 #ifndef FLUTTER_WEBRTC_RTC_VIDEO_RENDERER_HXX
 #define FLUTTER_WEBRTC_RTC_VIDEO_RENDERER_HXX
 
+#include <tbm_surface.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 #include "flutter_common.h"
 #include "flutter_webrtc_base.h"
@@ -19,13 +25,23 @@ class FlutterVideoRenderer
   FlutterVideoRenderer() = default;
   ~FlutterVideoRenderer();
 
+  FlutterVideoRenderer(const FlutterVideoRenderer&) = delete;
+  FlutterVideoRenderer& operator=(const FlutterVideoRenderer&) = delete;
+
+  // Returns true if frames can be rendered through GPU surfaces, in which
+  // case the GPU does the color conversion.
+  static bool IsGpuSurfaceSupported();
+
   void initialize(TextureRegistrar* registrar, BinaryMessenger* messenger,
                   std::unique_ptr<flutter::TextureVariant> texture,
-                  int64_t texture_id);
+                  int64_t texture_id, bool use_gpu_surface);
 
   virtual const FlutterDesktopPixelBuffer* CopyPixelBuffer(size_t width,
                                                            size_t height) const;
 
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainGpuSurface(
+      size_t width, size_t height) const;
+
   virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
 
   void SetVideoTrack(scoped_refptr<RTCVideoTrack> track);
@@ -36,6 +52,10 @@ class FlutterVideoRenderer
 
   bool CheckVideoTrack(std::string mediaId);
 
+  // Returns the numbers of frames received from the track, handed to Flutter
+  // and dropped without being rendered.
+  EncodableMap GetStats() const;
+
   std::string media_stream_id;
 
  private:
@@ -43,18 +63,62 @@ class FlutterVideoRenderer
     size_t width;
     size_t height;
   };
+
+  // A frame ready to be handed to Flutter, either converted to ABGR or
+  // copied into an NV12 tbm surface.
+  struct ConvertedFrame {
+    std::unique_ptr<uint8_t[]> data;
+    size_t capacity = 0;
+    FlutterDesktopPixelBuffer pixel_buffer = {};
+    tbm_surface_h surface = nullptr;
+    FlutterDesktopGpuSurfaceDescriptor gpu_surface = {};
+    // Set while the engine holds |surface|.
+    std::atomic<bool> in_use = false;
+  };
+
+  // Converts each new frame exactly once, off the raster thread.
+  void RunConverter();
+  bool ConvertToPixelBuffer(RTCVideoFrame* frame, ConvertedFrame& target);
+  bool CopyToSurface(RTCVideoFrame* frame, ConvertedFrame& target);
+  // Makes the latest converted frame the front buffer and returns it, or
+  // returns nullptr if no frame has been converted yet.
+  ConvertedFrame* TakeLatestFrame() const;
+
   FrameSize last_frame_size_ = {0, 0};
   bool first_frame_rendered = false;
   TextureRegistrar* registrar_ = nullptr;
   std::unique_ptr<EventChannelProxy> event_channel_;
   int64_t texture_id_ = -1;
   scoped_refptr<RTCVideoTrack> track_ = nullptr;
-  scoped_refptr<RTCVideoFrame> frame_;
   std::unique_ptr<flutter::TextureVariant> texture_;
-  std::shared_ptr<FlutterDesktopPixelBuffer> pixel_buffer_;
-  mutable std::shared_ptr<uint8_t> rgb_buffer_;
-  mutable std::mutex mutex_;
   RTCVideoFrame::VideoRotation rotation_ = RTCVideoFrame::kVideoRotation_0;
+  bool use_gpu_surface_ = false;
+
+  // The latest decoded frame that hasn't been converted yet. A frame that is
+  // superseded before the converter picks it up is dropped.
+  scoped_refptr<RTCVideoFrame> pending_frame_;
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cond_;
+  bool stopped_ = false;
+  std::thread converter_;
+  // Frames are not published faster than the display can show them.
+  std::chrono::steady_clock::time_point next_publish_time_;
+
+  std::atomic<int64_t> frames_received_ = 0;
+  mutable std::atomic<int64_t> frames_rendered_ = 0;
+  std::atomic<int64_t> frames_dropped_ = 0;
+
+  // Triple buffer: the converter writes into |back_index_|, publishes it as
+  // |ready_index_|, and CopyPixelBuffer() takes it as |front_index_|. The
+  // front buffer stays untouched until the next CopyPixelBuffer() call, so
+  // the lock is only held to swap indices.
+  mutable ConvertedFrame buffers_[3];
+  int back_index_ = 0;
+  mutable int ready_index_ = 1;
+  mutable int front_index_ = 2;
+  mutable bool has_ready_frame_ = false;
+  mutable bool has_front_frame_ = false;
+  mutable std::mutex mutex_;
 };
 
 class FlutterVideoRendererManager {
@@ -71,6 +135,9 @@ class FlutterVideoRendererManager {
   void VideoRendererDispose(int64_t texture_id,
                             std::unique_ptr<MethodResultProxy> result);
 
+  void VideoRendererGetStats(int64_t texture_id,
+                             std::unique_ptr<MethodResultProxy> result);
+
  private:
   FlutterWebRTCBase* base_;
   std::map<int64_t, scoped_refptr<FlutterVideoRenderer>> renderers_;
@@ -27,6 +27,8 @@ using namespace libwebrtc;
 class FlutterVideoRenderer;
 class FlutterRTCDataChannelObserver;
 class FlutterPeerConnectionObserver;
+class FlutterStatsSampler;
+class FlutterAudioLevelMonitor;
 
 class FlutterWebRTCBase {
  public:
@@ -36,6 +38,7 @@ class FlutterWebRTCBase {
   friend class FlutterDataChannel;
   friend class FlutterPeerConnectionObserver;
   friend class FlutterFrameCryptor;
+  friend class FlutterStatsSampling;
   enum ParseConstraintType { kMandatory, kOptional };
 
  public:
@@ -106,6 +109,9 @@ class FlutterWebRTCBase {
       data_channel_observers_;
   std::map<std::string, std::shared_ptr<FlutterPeerConnectionObserver>>
       peerconnection_observers_;
+  std::map<std::string, std::shared_ptr<FlutterStatsSampler>> stats_samplers_;
+  std::map<std::string, std::shared_ptr<FlutterAudioLevelMonitor>>
+      audio_level_monitors_;
   mutable std::mutex mutex_;
 
   void lock() { mutex_.lock(); }
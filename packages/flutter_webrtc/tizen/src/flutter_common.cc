@@ -1,5 +1,16 @@
 #include "flutter_common.h"
 
+#include <Ecore.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "log.h"
+
 class MethodCallProxyImpl : public MethodCallProxy {
  public:
   explicit MethodCallProxyImpl(const MethodCall& method_call)
@@ -64,6 +75,142 @@ std::unique_ptr<MethodResultProxy> MethodResultProxy::Create(
   return std::make_unique<MethodResultProxyImpl>(std::move(method_result));
 }
 
+// A lock-free multi-producer single-consumer queue (Vyukov). Push() may be
+// called from any thread, Pop() only from the consumer thread.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+  ~MpscQueue() {
+    T value;
+    while (Pop(value)) {
+    }
+    if (tail_ != &stub_) {
+      delete tail_;
+    }
+  }
+
+  void Push(T&& value) {
+    Node* node = new Node(std::move(value));
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Returns false if the queue is empty or a producer is in the middle of a
+  // Push(), in which case the producer schedules another drain.
+  bool Pop(T& value) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (!next) {
+      return false;
+    }
+    value = std::move(next->value);
+    tail_ = next;
+    if (tail != &stub_) {
+      delete tail;
+    }
+    return true;
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(T&& value) : value(std::move(value)) {}
+
+    std::atomic<Node*> next = nullptr;
+    T value;
+  };
+
+  Node stub_;
+  std::atomic<Node*> head_;
+  Node* tail_;
+};
+
+class EventChannelProxyImpl;
+
+// Marshals events posted from any thread (libwebrtc signaling, worker and
+// decoder threads) to the platform thread in batches.
+class EventDispatcher {
+ public:
+  static EventDispatcher& GetInstance() {
+    static EventDispatcher instance;
+    return instance;
+  }
+
+  uint64_t Register(EventChannelProxyImpl* proxy) {
+    std::lock_guard<std::mutex> lock(proxies_mutex_);
+    uint64_t id = next_id_++;
+    proxies_[id] = proxy;
+    return id;
+  }
+
+  // Pending events of the proxy are dropped.
+  void Unregister(uint64_t id) {
+    std::lock_guard<std::mutex> lock(proxies_mutex_);
+    proxies_.erase(id);
+  }
+
+  void Post(uint64_t proxy_id, EncodableValue&& event, bool cache_event);
+
+ private:
+  struct PendingEvent {
+    uint64_t proxy_id = 0;
+    EncodableValue event;
+    bool cache_event = false;
+  };
+
+  EventDispatcher() = default;
+
+  void Dispatch();
+
+  MpscQueue<PendingEvent> queue_;
+  std::atomic<size_t> pending_count_ = 0;
+  // The number of superseded events dropped because of the backlog.
+  std::atomic<size_t> dropped_count_ = 0;
+  // The number of other events dropped because the backlog hit the hard cap.
+  std::atomic<size_t> overflow_count_ = 0;
+  std::atomic<bool> is_scheduled_ = false;
+
+  std::mutex proxies_mutex_;
+  std::map<uint64_t, EventChannelProxyImpl*> proxies_;
+  uint64_t next_id_ = 1;
+};
+
+// Beyond this backlog, events that are superseded by later ones (see
+// IsSupersededEvent()) are dropped until the platform thread catches up.
+// Other events are still queued, since losing them breaks the app state.
+static constexpr size_t kMaxPendingEvents = 4096;
+// Beyond this backlog, all events are dropped so that memory stays bounded if
+// the platform thread is stalled.
+static constexpr size_t kMaxPendingEventsHardCap = 65536;
+
+static std::string EventName(const EncodableValue& event) {
+  const auto* map = std::get_if<EncodableMap>(&event);
+  if (!map) {
+    return std::string();
+  }
+  auto it = map->find(EncodableValue("event"));
+  if (it == map->end() || !TypeIs<std::string>(it->second)) {
+    return std::string();
+  }
+  return std::get<std::string>(it->second);
+}
+
+// Only the last of these events in a batch is delivered.
+static bool IsSupersededEvent(const std::string& name) {
+  return name == "didTextureChangeVideoSize" ||
+         name == "didTextureChangeRotation" ||
+         name == "dataChannelBufferedAmountChange";
+}
+
+// These events are not delivered if identical to the previous one.
+static bool IsStateEvent(const std::string& name) {
+  return name == "peerConnectionState" || name == "iceConnectionState" ||
+         name == "iceGatheringState" || name == "signalingState" ||
+         name == "dataChannelStateChanged";
+}
+
 class EventChannelProxyImpl : public EventChannelProxy {
  public:
   EventChannelProxyImpl(BinaryMessenger* messenger,
@@ -91,16 +238,39 @@ class EventChannelProxyImpl : public EventChannelProxy {
         });
 
     channel_->SetStreamHandler(std::move(handler));
+    id_ = EventDispatcher::GetInstance().Register(this);
   }
 
-  virtual ~EventChannelProxyImpl() {}
+  virtual ~EventChannelProxyImpl() {
+    EventDispatcher::GetInstance().Unregister(id_);
+  }
 
+  // May be called from any thread.
   void Success(const EncodableValue& event, bool cache_event = true) override {
+    EventDispatcher::GetInstance().Post(id_, EncodableValue(event),
+                                        cache_event);
+  }
+
+  // May be called from any thread.
+  void Success(EncodableValue&& event, bool cache_event = true) override {
+    EventDispatcher::GetInstance().Post(id_, std::move(event), cache_event);
+  }
+
+  // Called on the platform thread.
+  void Deliver(const std::string& name, EncodableValue& event,
+               bool cache_event) {
+    if (IsStateEvent(name)) {
+      auto it = last_states_.find(name);
+      if (it != last_states_.end() && it->second == event) {
+        return;
+      }
+      last_states_[name] = event;
+    }
     if (on_listen_called_) {
       sink_->Success(event);
     } else {
       if (cache_event) {
-        event_queue_.push_back(event);
+        event_queue_.push_back(std::move(event));
       }
     }
   }
@@ -110,8 +280,82 @@ class EventChannelProxyImpl : public EventChannelProxy {
   std::unique_ptr<EventSink> sink_;
   std::list<EncodableValue> event_queue_;
   bool on_listen_called_ = false;
+  uint64_t id_ = 0;
+  std::map<std::string, EncodableValue> last_states_;
 };
 
+void EventDispatcher::Post(uint64_t proxy_id, EncodableValue&& event,
+                           bool cache_event) {
+  size_t pending_count =
+      pending_count_.fetch_add(1, std::memory_order_relaxed);
+  if (pending_count >= kMaxPendingEventsHardCap) {
+    pending_count_.fetch_sub(1, std::memory_order_relaxed);
+    overflow_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (pending_count >= kMaxPendingEvents &&
+      IsSupersededEvent(EventName(event))) {
+    pending_count_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  queue_.Push(PendingEvent{proxy_id, std::move(event), cache_event});
+
+  // Wake up the platform thread only once per batch.
+  if (!is_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+    ecore_main_loop_thread_safe_call_async(
+        [](void* data) { static_cast<EventDispatcher*>(data)->Dispatch(); },
+        this);
+  }
+}
+
+void EventDispatcher::Dispatch() {
+  // Cleared before draining so that events pushed from now on schedule
+  // another dispatch.
+  is_scheduled_.store(false, std::memory_order_release);
+
+  std::vector<PendingEvent> events;
+  PendingEvent event;
+  while (queue_.Pop(event)) {
+    events.push_back(std::move(event));
+  }
+  pending_count_.fetch_sub(events.size(), std::memory_order_relaxed);
+
+  size_t dropped_count = dropped_count_.exchange(0, std::memory_order_relaxed);
+  if (dropped_count > 0) {
+    LOG_WARN("Dropped %zu superseded events, the event backlog is full.",
+             dropped_count);
+  }
+  size_t overflow_count =
+      overflow_count_.exchange(0, std::memory_order_relaxed);
+  if (overflow_count > 0) {
+    LOG_ERROR("Dropped %zu events, the event backlog exceeded %zu events.",
+              overflow_count, kMaxPendingEventsHardCap);
+  }
+
+  std::vector<std::string> names(events.size());
+  std::vector<bool> superseded(events.size(), false);
+  std::set<std::pair<uint64_t, std::string>> seen;
+  for (size_t i = events.size(); i-- > 0;) {
+    names[i] = EventName(events[i].event);
+    if (IsSupersededEvent(names[i]) &&
+        !seen.emplace(events[i].proxy_id, names[i]).second) {
+      superseded[i] = true;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(proxies_mutex_);
+  for (size_t i = 0; i < events.size(); i++) {
+    if (superseded[i]) {
+      continue;
+    }
+    auto it = proxies_.find(events[i].proxy_id);
+    if (it != proxies_.end()) {
+      it->second->Deliver(names[i], events[i].event, events[i].cache_event);
+    }
+  }
+}
+
 std::unique_ptr<EventChannelProxy> EventChannelProxy::Create(
     BinaryMessenger* messenger, const std::string& channelName) {
   return std::make_unique<EventChannelProxyImpl>(messenger, channelName);
@@ -10,9 +10,108 @@ FlutterRTCDataChannelObserver::FlutterRTCDataChannelObserver(
     : event_channel_(EventChannelProxy::Create(messenger, channelName)),
       data_channel_(data_channel) {
   data_channel_->RegisterObserver(this);
+  sender_ = std::thread(&FlutterRTCDataChannelObserver::RunSender, this);
 }
 
-FlutterRTCDataChannelObserver::~FlutterRTCDataChannelObserver() {}
+FlutterRTCDataChannelObserver::~FlutterRTCDataChannelObserver() {
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    stopped_ = true;
+  }
+  send_cond_.notify_one();
+  sender_.join();
+}
+
+void FlutterRTCDataChannelObserver::Send(const uint8_t* data, size_t size,
+                                         bool binary) {
+  uint64_t amount;
+  int64_t changed_amount;
+  bool crossed;
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_queue_.push_back(Message{std::vector<uint8_t>(data, data + size),
+                                  binary});
+    queued_amount_ += size;
+    amount = queued_amount_;
+    crossed = CrossesThreshold(amount, &changed_amount);
+  }
+  send_cond_.notify_one();
+  if (crossed) {
+    NotifyBufferedAmountChange(amount, changed_amount);
+  }
+}
+
+uint64_t FlutterRTCDataChannelObserver::buffered_amount() {
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  return queued_amount_;
+}
+
+void FlutterRTCDataChannelObserver::set_buffered_amount_low_threshold(
+    uint64_t threshold) {
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  buffered_amount_low_threshold_ = threshold;
+}
+
+bool FlutterRTCDataChannelObserver::CrossesThreshold(uint64_t amount,
+                                                     int64_t* changed_amount) {
+  bool above_threshold = amount > buffered_amount_low_threshold_;
+  if (above_threshold == above_threshold_) {
+    return false;
+  }
+  above_threshold_ = above_threshold;
+  *changed_amount = static_cast<int64_t>(amount) -
+                    static_cast<int64_t>(last_reported_amount_);
+  last_reported_amount_ = amount;
+  return true;
+}
+
+void FlutterRTCDataChannelObserver::RunSender() {
+  while (true) {
+    std::deque<Message> messages;
+    {
+      std::unique_lock<std::mutex> lock(send_mutex_);
+      send_cond_.wait(lock,
+                      [this] { return stopped_ || !send_queue_.empty(); });
+      if (stopped_) {
+        break;
+      }
+      messages.swap(send_queue_);
+    }
+
+    uint64_t sent_amount = 0;
+    for (const Message& message : messages) {
+      data_channel_->Send(message.data.data(),
+                          static_cast<uint32_t>(message.data.size()),
+                          message.binary);
+      sent_amount += message.data.size();
+    }
+
+    uint64_t amount;
+    int64_t changed_amount;
+    bool crossed;
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      queued_amount_ -= sent_amount;
+      amount = queued_amount_;
+      crossed = CrossesThreshold(amount, &changed_amount);
+    }
+    if (crossed) {
+      NotifyBufferedAmountChange(amount, changed_amount);
+    }
+  }
+}
+
+void FlutterRTCDataChannelObserver::NotifyBufferedAmountChange(
+    uint64_t buffered_amount, int64_t changed_amount) {
+  EncodableMap params;
+  params[EncodableValue("event")] =
+      EncodableValue("dataChannelBufferedAmountChange");
+  params[EncodableValue("id")] = EncodableValue(data_channel_->id());
+  params[EncodableValue("bufferedAmount")] =
+      EncodableValue(static_cast<int64_t>(buffered_amount));
+  params[EncodableValue("changedAmount")] = EncodableValue(changed_amount);
+  event_channel_->Success(EncodableValue(std::move(params)), false);
+}
 
 void FlutterDataChannel::CreateDataChannel(
     const std::string& peerConnectionId, const std::string& label,
@@ -66,21 +165,47 @@ void FlutterDataChannel::CreateDataChannel(
 }
 
 void FlutterDataChannel::DataChannelSend(
-    RTCDataChannel* data_channel, const std::string& type,
+    FlutterRTCDataChannelObserver* observer, const std::string& type,
     const EncodableValue& data, std::unique_ptr<MethodResultProxy> result) {
+  // Send straight from the decoded arguments without copying them first.
   bool is_binary = type == "binary";
-  if (is_binary && TypeIs<std::vector<uint8_t>>(data)) {
-    std::vector<uint8_t> buffer = GetValue<std::vector<uint8_t>>(data);
-    data_channel->Send(buffer.data(), static_cast<uint32_t>(buffer.size()),
-                       true);
+  const auto* buffer = std::get_if<std::vector<uint8_t>>(&data);
+  const auto* str = std::get_if<std::string>(&data);
+  if (is_binary && buffer) {
+    observer->Send(buffer->data(), buffer->size(), true);
+  } else if (str) {
+    observer->Send(reinterpret_cast<const uint8_t*>(str->data()), str->size(),
+                   false);
   } else {
-    std::string str = GetValue<std::string>(data);
-    data_channel->Send(reinterpret_cast<const uint8_t*>(str.c_str()),
-                       static_cast<uint32_t>(str.length()), false);
+    result->Error("dataChannelSendFailed",
+                  "dataChannelSend() data is not a string or binary");
+    return;
   }
   result->Success();
 }
 
+void FlutterDataChannel::DataChannelGetBufferedAmount(
+    FlutterRTCDataChannelObserver* observer,
+    std::unique_ptr<MethodResultProxy> result) {
+  EncodableMap params;
+  params[EncodableValue("bufferedAmount")] =
+      EncodableValue(static_cast<int64_t>(observer->buffered_amount()));
+  result->Success(EncodableValue(params));
+}
+
+void FlutterDataChannel::DataChannelSetBufferedAmountLowThreshold(
+    FlutterRTCDataChannelObserver* observer, int64_t threshold,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (threshold < 0) {
+    result->Error("dataChannelSetBufferedAmountLowThresholdFailed",
+                  "The threshold must be non-negative");
+    return;
+  }
+  observer->set_buffered_amount_low_threshold(
+      static_cast<uint64_t>(threshold));
+  result->Success();
+}
+
 void FlutterDataChannel::DataChannelClose(
     RTCDataChannel* data_channel, const std::string& data_channel_uuid,
     std::unique_ptr<MethodResultProxy> result) {
@@ -102,6 +227,15 @@ RTCDataChannel* FlutterDataChannel::DataChannelForId(const std::string& uuid) {
   return nullptr;
 }
 
+FlutterRTCDataChannelObserver* FlutterDataChannel::DataChannelObserverForId(
+    const std::string& uuid) {
+  auto it = base_->data_channel_observers_.find(uuid);
+  if (it != base_->data_channel_observers_.end()) {
+    return it->second.get();
+  }
+  return nullptr;
+}
+
 static const char* DataStateString(RTCDataChannelState state) {
   switch (state) {
     case RTCDataChannelConnecting:
@@ -122,7 +256,7 @@ void FlutterRTCDataChannelObserver::OnStateChange(RTCDataChannelState state) {
   params[EncodableValue("id")] = EncodableValue(data_channel_->id());
   params[EncodableValue("state")] = EncodableValue(DataStateString(state));
   auto data = EncodableValue(params);
-  event_channel_->Success(data);
+  event_channel_->Success(std::move(data));
 }
 
 void FlutterRTCDataChannelObserver::OnMessage(const char* buffer, int length,
@@ -132,12 +266,11 @@ void FlutterRTCDataChannelObserver::OnMessage(const char* buffer, int length,
 
   params[EncodableValue("id")] = EncodableValue(data_channel_->id());
   params[EncodableValue("type")] = EncodableValue(binary ? "binary" : "text");
-  std::string str(buffer, length);
+  // Build the payload directly from |buffer| so that it is copied only once.
   params[EncodableValue("data")] =
-      binary ? EncodableValue(std::vector<uint8_t>(str.begin(), str.end()))
-             : EncodableValue(str);
+      binary ? EncodableValue(std::vector<uint8_t>(buffer, buffer + length))
+             : EncodableValue(std::string(buffer, length));
 
-  auto data = EncodableValue(params);
-  event_channel_->Success(data);
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 }  // namespace flutter_webrtc_plugin
@@ -0,0 +1,135 @@
+#include "flutter_frame_capturer.h"
+
+#include <image_util.h>
+
+#include <cctype>
+#include <thread>
+
+#include "log.h"
+
+namespace flutter_webrtc_plugin {
+
+// Gives up if the track doesn't produce a frame within this time, e.g. when
+// it is muted.
+static constexpr double kCaptureTimeoutSec = 5.0;
+
+static bool HasSuffix(const std::string& str, const std::string& suffix) {
+  if (str.size() < suffix.size()) {
+    return false;
+  }
+  std::string tail = str.substr(str.size() - suffix.size());
+  for (char& c : tail) {
+    c = static_cast<char>(tolower(c));
+  }
+  return tail == suffix;
+}
+
+FlutterFrameCapturer::FlutterFrameCapturer(RTCVideoTrack* track,
+                                           std::string path)
+    : track_(track), path_(std::move(path)) {}
+
+FlutterFrameCapturer::~FlutterFrameCapturer() {}
+
+void FlutterFrameCapturer::CaptureFrame(
+    std::unique_ptr<MethodResultProxy> result) {
+  result_ = std::move(result);
+
+  // Keeps this alive until Complete() is called.
+  AddRef();
+  timeout_timer_ = ecore_timer_add(
+      kCaptureTimeoutSec,
+      [](void* data) -> Eina_Bool {
+        auto* self = static_cast<FlutterFrameCapturer*>(data);
+        self->timeout_timer_ = nullptr;
+        if (!self->catch_frame_.exchange(true)) {
+          self->track_->RemoveRenderer(self);
+          self->Complete(false, "No frame received from the track.");
+        }
+        return ECORE_CALLBACK_CANCEL;
+      },
+      this);
+  track_->AddRenderer(this);
+}
+
+void FlutterFrameCapturer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  if (catch_frame_.exchange(true)) {
+    return;
+  }
+  // Never convert or encode on the WebRTC thread that delivers the frame.
+  scoped_refptr<FlutterFrameCapturer> self(this);
+  std::thread([self, frame]() { self->SaveFrame(frame); }).detach();
+}
+
+void FlutterFrameCapturer::SaveFrame(scoped_refptr<RTCVideoFrame> frame) {
+  track_->RemoveRenderer(this);
+
+  int width = frame->width();
+  int height = frame->height();
+  size_t buffer_size = static_cast<size_t>(width) * height * (32 >> 3);
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+  // kABGR is laid out as R, G, B, A in memory.
+  frame->ConvertToARGB(RTCVideoFrame::Type::kABGR, buffer.get(), 0, width,
+                       height);
+  frame = nullptr;
+
+  image_util_image_h image = nullptr;
+  int ret = image_util_create_image(width, height,
+                                    IMAGE_UTIL_COLORSPACE_RGBA8888,
+                                    buffer.get(), buffer_size, &image);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    LOG_ERROR("image_util_create_image failed: %d", ret);
+    PostComplete(false, "Failed to create an image.");
+    return;
+  }
+
+  image_util_type_e type = HasSuffix(path_, ".png") ? IMAGE_UTIL_PNG
+                                                    : IMAGE_UTIL_JPEG;
+  image_util_encode_h encoder = nullptr;
+  ret = image_util_encode_create(type, &encoder);
+  if (ret == IMAGE_UTIL_ERROR_NONE) {
+    ret = image_util_encode_run_to_file(encoder, image, path_.c_str());
+    image_util_encode_destroy(encoder);
+  }
+  image_util_destroy_image(image);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    LOG_ERROR("Failed to encode the frame to %s: %d", path_.c_str(), ret);
+    PostComplete(false, "Failed to save the frame to " + path_);
+    return;
+  }
+  PostComplete(true, std::string());
+}
+
+void FlutterFrameCapturer::PostComplete(bool success,
+                                        const std::string& error_message) {
+  struct Completion {
+    scoped_refptr<FlutterFrameCapturer> capturer;
+    bool success;
+    std::string error_message;
+  };
+  auto* completion = new Completion{this, success, error_message};
+  ecore_main_loop_thread_safe_call_async(
+      [](void* data) {
+        auto* completion = static_cast<Completion*>(data);
+        completion->capturer->Complete(completion->success,
+                                       completion->error_message);
+        delete completion;
+      },
+      completion);
+}
+
+void FlutterFrameCapturer::Complete(bool success,
+                                    const std::string& error_message) {
+  if (timeout_timer_) {
+    ecore_timer_del(timeout_timer_);
+    timeout_timer_ = nullptr;
+  }
+  if (success) {
+    result_->Success();
+  } else {
+    result_->Error("captureFrame", error_message);
+  }
+  result_.reset();
+  Release();
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -43,7 +43,7 @@ void FlutterFrameCryptorObserver::OnFrameCryptionStateChanged(
       EncodableValue(participant_id.std_string());
   params[EncodableValue("state")] =
       EncodableValue(frameCryptionStateToString(state));
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 bool FlutterFrameCryptor::HandleFrameCryptorMethodCall(
@@ -54,7 +54,7 @@ bool FlutterFrameCryptor::HandleFrameCryptorMethodCall(
     result->Error("Bad Arguments", "Null arguments received");
     return true;
   }
-  const EncodableMap params = GetValue<EncodableMap>(*method_call.arguments());
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
   if (method_name == "frameCryptorFactoryCreateFrameCryptor") {
     FrameCryptorFactoryCreateFrameCryptor(params, std::move(result));
@@ -312,8 +312,9 @@ void FlutterFrameCryptor::FrameCryptorFactoryCreateKeyProvider(
     std::unique_ptr<MethodResultProxy> result) {
   libwebrtc::KeyProviderOptions options;
 
-  auto keyProviderOptions = findMap(constraints, "keyProviderOptions");
-  if (keyProviderOptions == EncodableMap()) {
+  const EncodableMap& keyProviderOptions =
+      findMap(constraints, "keyProviderOptions");
+  if (keyProviderOptions.empty()) {
     result->Error("FrameCryptorFactoryCreateKeyProviderFailed",
                   "keyProviderOptions is null");
     return;
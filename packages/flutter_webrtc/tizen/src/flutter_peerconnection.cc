@@ -1,7 +1,12 @@
 #include "flutter_peerconnection.h"
 
+#include <cctype>
+#include <set>
+
 #include "base/scoped_ref_ptr.h"
 #include "flutter_data_channel.h"
+#include "flutter_frame_capturer.h"
+#include "flutter_stats_sampler.h"
 #include "rtc_dtmf_sender.h"
 #include "rtc_rtp_parameters.h"
 
@@ -107,6 +112,174 @@ const char* iceGatheringStateString(RTCIceGatheringState state) {
   return "";
 }
 
+std::string priorityToString(libwebrtc::RTCPriority priority) {
+  switch (priority) {
+    case libwebrtc::RTCPriority::kVeryLow:
+      return "very-low";
+    case libwebrtc::RTCPriority::kLow:
+      return "low";
+    case libwebrtc::RTCPriority::kMedium:
+      return "medium";
+    case libwebrtc::RTCPriority::kHigh:
+      return "high";
+  }
+  return "low";
+}
+
+static bool stringToPriority(const std::string& str,
+                             libwebrtc::RTCPriority* priority) {
+  if (str == "very-low") {
+    *priority = libwebrtc::RTCPriority::kVeryLow;
+  } else if (str == "low") {
+    *priority = libwebrtc::RTCPriority::kLow;
+  } else if (str == "medium") {
+    *priority = libwebrtc::RTCPriority::kMedium;
+  } else if (str == "high") {
+    *priority = libwebrtc::RTCPriority::kHigh;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool stringToDegradationPreference(
+    const std::string& str, libwebrtc::RTCDegradationPreference* preference) {
+  if (str == "maintain-framerate") {
+    *preference = libwebrtc::RTCDegradationPreference::MAINTAIN_FRAMERATE;
+  } else if (str == "maintain-resolution") {
+    *preference = libwebrtc::RTCDegradationPreference::MAINTAIN_RESOLUTION;
+  } else if (str == "balanced") {
+    *preference = libwebrtc::RTCDegradationPreference::BALANCED;
+  } else if (str == "disabled") {
+    *preference = libwebrtc::RTCDegradationPreference::DISABLED;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Dart sends whole numbers as int and fractional numbers as double.
+static bool toDouble(const EncodableValue& value, double* out) {
+  if (TypeIs<double>(value)) {
+    *out = GetValue<double>(value);
+  } else if (TypeIs<int32_t>(value)) {
+    *out = GetValue<int32_t>(value);
+  } else if (TypeIs<int64_t>(value)) {
+    *out = static_cast<double>(GetValue<int64_t>(value));
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool isValidRid(const std::string& rid) {
+  if (rid.empty() || rid.size() > 16) {
+    return false;
+  }
+  for (char c : rid) {
+    if (!isalnum(static_cast<unsigned char>(c))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns an error message if the given encodings can't be applied, or an
+// empty string otherwise.
+static std::string validateEncodings(const EncodableList& encodings) {
+  std::set<std::string> rids;
+  for (const EncodableValue& item : encodings) {
+    if (!TypeIs<EncodableMap>(item)) {
+      return "encoding is not a map";
+    }
+    const EncodableMap& map = GetValue<EncodableMap>(item);
+    double number;
+
+    // An empty rid is what getParameters() reports for a non-simulcast
+    // encoding, so treat it the same as an absent one.
+    EncodableValue value = findEncodableValue(map, "rid");
+    if (TypeIs<std::string>(value) && GetValue<std::string>(value).empty()) {
+      value = EncodableValue();
+    }
+    if (!value.IsNull()) {
+      if (!TypeIs<std::string>(value) ||
+          !isValidRid(GetValue<std::string>(value))) {
+        return "rid must be 1 to 16 alphanumeric characters";
+      }
+      if (!rids.insert(GetValue<std::string>(value)).second) {
+        return "rid must be unique";
+      }
+    } else if (encodings.size() > 1) {
+      return "rid is required for simulcast encodings";
+    }
+
+    value = findEncodableValue(map, "active");
+    if (!value.IsNull() && !TypeIs<bool>(value)) {
+      return "active must be a boolean";
+    }
+    value = findEncodableValue(map, "adaptivePtime");
+    if (!value.IsNull() && !TypeIs<bool>(value)) {
+      return "adaptivePtime must be a boolean";
+    }
+    value = findEncodableValue(map, "scalabilityMode");
+    if (!value.IsNull() && !TypeIs<std::string>(value)) {
+      return "scalabilityMode must be a string";
+    }
+
+    double min_bitrate = 0;
+    double max_bitrate = 0;
+    value = findEncodableValue(map, "minBitrate");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &min_bitrate) || min_bitrate < 0) {
+        return "minBitrate must be a non-negative number";
+      }
+    }
+    value = findEncodableValue(map, "maxBitrate");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &max_bitrate) || max_bitrate < 0) {
+        return "maxBitrate must be a non-negative number";
+      }
+    }
+    if (max_bitrate > 0 && min_bitrate > max_bitrate) {
+      return "minBitrate must not exceed maxBitrate";
+    }
+
+    value = findEncodableValue(map, "maxFramerate");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &number) || number < 0) {
+        return "maxFramerate must be a non-negative number";
+      }
+    }
+    value = findEncodableValue(map, "scaleResolutionDownBy");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &number) || number < 1.0) {
+        return "scaleResolutionDownBy must be at least 1.0";
+      }
+    }
+    value = findEncodableValue(map, "numTemporalLayers");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &number) || number < 1 || number > 4) {
+        return "numTemporalLayers must be between 1 and 4";
+      }
+    }
+    value = findEncodableValue(map, "bitratePriority");
+    if (!value.IsNull()) {
+      if (!toDouble(value, &number) || number <= 0) {
+        return "bitratePriority must be a positive number";
+      }
+    }
+    value = findEncodableValue(map, "networkPriority");
+    if (!value.IsNull()) {
+      libwebrtc::RTCPriority priority;
+      if (!TypeIs<std::string>(value) ||
+          !stringToPriority(GetValue<std::string>(value), &priority)) {
+        return "networkPriority must be very-low, low, medium or high";
+      }
+    }
+  }
+  return std::string();
+}
+
 EncodableMap rtpParametersToMap(
     libwebrtc::scoped_refptr<libwebrtc::RTCRtpParameters> rtpParameters) {
   EncodableMap info;
@@ -150,7 +323,19 @@ EncodableMap rtpParametersToMap(
     map[EncodableValue("scalabilityMode")] =
         EncodableValue(encoding->scalability_mode().std_string());
     map[EncodableValue("ssrc")] =
-        EncodableValue(static_cast<int>(encoding->ssrc()));
+        EncodableValue(static_cast<int64_t>(encoding->ssrc()));
+    std::string rid = encoding->rid().std_string();
+    if (!rid.empty()) {
+      map[EncodableValue("rid")] = EncodableValue(rid);
+    }
+    map[EncodableValue("numTemporalLayers")] =
+        EncodableValue(encoding->num_temporal_layers());
+    map[EncodableValue("bitratePriority")] =
+        EncodableValue(encoding->bitrate_priority());
+    map[EncodableValue("networkPriority")] =
+        EncodableValue(priorityToString(encoding->network_priority()));
+    map[EncodableValue("adaptivePtime")] =
+        EncodableValue(encoding->adaptive_ptime());
     encodings_info.push_back(EncodableValue(map));
   }
   info[EncodableValue("encodings")] = EncodableValue(encodings_info);
@@ -358,6 +543,22 @@ void FlutterPeerConnection::RTCPeerConnectionClose(
   if (it2 != base_->peerconnection_observers_.end())
     base_->peerconnection_observers_.erase(it2);
 
+  auto it3 = base_->stats_samplers_.find(uuid);
+  if (it3 != base_->stats_samplers_.end()) {
+    it3->second->Stop();
+    base_->stats_samplers_.erase(it3);
+  }
+
+  for (auto it4 = base_->audio_level_monitors_.begin();
+       it4 != base_->audio_level_monitors_.end();) {
+    if (it4->second->peer_connection_id() == uuid) {
+      it4->second->Stop();
+      it4 = base_->audio_level_monitors_.erase(it4);
+    } else {
+      it4++;
+    }
+  }
+
   result->Success();
 }
 
@@ -459,10 +660,10 @@ void FlutterPeerConnection::GetRemoteDescription(
 
 scoped_refptr<RTCRtpTransceiverInit>
 FlutterPeerConnection::mapToRtpTransceiverInit(const EncodableMap& params) {
-  EncodableList streamIds = findList(params, "streamIds");
+  const EncodableList& streamIds = findList(params, "streamIds");
 
   std::vector<string> stream_ids;
-  for (auto item : streamIds) {
+  for (const EncodableValue& item : streamIds) {
     std::string id = GetValue<std::string>(item);
     stream_ids.push_back(id.c_str());
   }
@@ -471,9 +672,9 @@ FlutterPeerConnection::mapToRtpTransceiverInit(const EncodableMap& params) {
   if (!direction.IsNull()) {
     dir = stringToTransceiverDirection(GetValue<std::string>(direction));
   }
-  EncodableList sendEncodings = findList(params, "sendEncodings");
+  const EncodableList& sendEncodings = findList(params, "sendEncodings");
   std::vector<scoped_refptr<RTCRtpEncodingParameters>> encodings;
-  for (EncodableValue value : sendEncodings) {
+  for (const EncodableValue& value : sendEncodings) {
     encodings.push_back(mapToEncoding(GetValue<EncodableMap>(value)));
   }
   scoped_refptr<RTCRtpTransceiverInit> init =
@@ -504,46 +705,52 @@ FlutterPeerConnection::mapToEncoding(const EncodableMap& params) {
 
   encoding->set_active(true);
   encoding->set_scale_resolution_down_by(1.0);
+  applyEncoding(params, encoding);
+  return encoding;
+}
 
+void FlutterPeerConnection::applyEncoding(
+    const EncodableMap& params,
+    scoped_refptr<RTCRtpEncodingParameters> encoding) {
+  double number;
   EncodableValue value = findEncodableValue(params, "active");
   if (!value.IsNull()) {
     encoding->set_active(GetValue<bool>(value));
   }
 
   value = findEncodableValue(params, "rid");
-  if (!value.IsNull()) {
-    const std::string rid = GetValue<std::string>(value);
-    encoding->set_rid(rid.c_str());
+  if (TypeIs<std::string>(value)) {
+    encoding->set_rid(GetValue<std::string>(value));
   }
 
   value = findEncodableValue(params, "ssrc");
-  if (!value.IsNull()) {
-    encoding->set_ssrc((uint32_t)GetValue<int>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_ssrc(static_cast<uint32_t>(number));
   }
 
   value = findEncodableValue(params, "minBitrate");
-  if (!value.IsNull()) {
-    encoding->set_min_bitrate_bps(GetValue<int>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_min_bitrate_bps(static_cast<int>(number));
   }
 
   value = findEncodableValue(params, "maxBitrate");
-  if (!value.IsNull()) {
-    encoding->set_max_bitrate_bps(GetValue<int>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_max_bitrate_bps(static_cast<int>(number));
   }
 
   value = findEncodableValue(params, "maxFramerate");
-  if (!value.IsNull()) {
-    encoding->set_max_framerate(GetValue<int>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_max_framerate(number);
   }
 
   value = findEncodableValue(params, "numTemporalLayers");
-  if (!value.IsNull()) {
-    encoding->set_num_temporal_layers(GetValue<int>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_num_temporal_layers(static_cast<int>(number));
   }
 
   value = findEncodableValue(params, "scaleResolutionDownBy");
-  if (!value.IsNull()) {
-    encoding->set_scale_resolution_down_by(GetValue<double>(value));
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_scale_resolution_down_by(number);
   }
 
   value = findEncodableValue(params, "scalabilityMode");
@@ -551,7 +758,22 @@ FlutterPeerConnection::mapToEncoding(const EncodableMap& params) {
     encoding->set_scalability_mode(GetValue<std::string>(value));
   }
 
-  return encoding;
+  value = findEncodableValue(params, "bitratePriority");
+  if (!value.IsNull() && toDouble(value, &number)) {
+    encoding->set_bitrate_priority(number);
+  }
+
+  value = findEncodableValue(params, "networkPriority");
+  libwebrtc::RTCPriority priority;
+  if (!value.IsNull() &&
+      stringToPriority(GetValue<std::string>(value), &priority)) {
+    encoding->set_network_priority(priority);
+  }
+
+  value = findEncodableValue(params, "adaptivePtime");
+  if (!value.IsNull()) {
+    encoding->set_adaptive_ptime(GetValue<bool>(value));
+  }
 }
 
 RTCMediaType stringToMediaType(const std::string& mediaType) {
@@ -574,6 +796,13 @@ void FlutterPeerConnection::AddTransceiver(
   RTCMediaTrack* track = base_->MediaTrackForId(trackId);
   RTCMediaType type = stringToMediaType(mediaType);
 
+  std::string error =
+      validateEncodings(findList(transceiverInit, "sendEncodings"));
+  if (!error.empty()) {
+    result_ptr->Error("AddTransceiver(track | mediaType, init)", error);
+    return;
+  }
+
   if (0 < transceiverInit.size()) {
     auto transceiver =
         track != nullptr ? pc->AddTransceiver(
@@ -667,72 +896,26 @@ void FlutterPeerConnection::RtpSenderReplaceTrack(
 }
 
 scoped_refptr<RTCRtpParameters> FlutterPeerConnection::updateRtpParameters(
-    EncodableMap newParameters, scoped_refptr<RTCRtpParameters> parameters) {
-  EncodableList encodings = findList(newParameters, "encodings");
+    const EncodableMap& newParameters,
+    scoped_refptr<RTCRtpParameters> parameters) {
+  const EncodableList& encodings = findList(newParameters, "encodings");
   auto encoding = encodings.begin();
   auto params = parameters->encodings();
   for (auto param : params.std_vector()) {
     if (encoding != encodings.end()) {
-      EncodableMap map = GetValue<EncodableMap>(*encoding);
-      EncodableValue value = findEncodableValue(map, "active");
-      if (!value.IsNull()) {
-        param->set_active(GetValue<bool>(value));
-      }
-      value = findEncodableValue(map, "rid");
-      if (!value.IsNull()) {
-        param->set_rid(GetValue<std::string>(value));
-      }
-      value = findEncodableValue(map, "ssrc");
-      if (!value.IsNull()) {
-        param->set_ssrc(GetValue<int>(value));
-      }
-      value = findEncodableValue(map, "maxBitrate");
-      if (!value.IsNull()) {
-        param->set_max_bitrate_bps(GetValue<int>(value));
-      }
-
-      value = findEncodableValue(map, "minBitrate");
-      if (!value.IsNull()) {
-        param->set_min_bitrate_bps(GetValue<int>(value));
-      }
-
-      value = findEncodableValue(map, "maxFramerate");
-      if (!value.IsNull()) {
-        param->set_max_framerate(GetValue<int>(value));
-      }
-      value = findEncodableValue(map, "numTemporalLayers");
-      if (!value.IsNull()) {
-        param->set_num_temporal_layers(GetValue<int>(value));
-      }
-      value = findEncodableValue(map, "scaleResolutionDownBy");
-      if (!value.IsNull()) {
-        param->set_scale_resolution_down_by(GetValue<double>(value));
-      }
-      value = findEncodableValue(map, "scalabilityMode");
-      if (!value.IsNull()) {
-        param->set_scalability_mode(GetValue<std::string>(value));
-      }
+      applyEncoding(GetValue<EncodableMap>(*encoding), param);
       encoding++;
     }
   }
+  parameters->set_encodings(params);
 
   EncodableValue value =
       findEncodableValue(newParameters, "degradationPreference");
-  if (!value.IsNull()) {
-    const std::string degradationPreference = GetValue<std::string>(value);
-    if (degradationPreference == "maintain-framerate") {
-      parameters->SetDegradationPreference(
-          libwebrtc::RTCDegradationPreference::MAINTAIN_FRAMERATE);
-    } else if (degradationPreference == "maintain-resolution") {
-      parameters->SetDegradationPreference(
-          libwebrtc::RTCDegradationPreference::MAINTAIN_RESOLUTION);
-    } else if (degradationPreference == "balanced") {
-      parameters->SetDegradationPreference(
-          libwebrtc::RTCDegradationPreference::BALANCED);
-    } else if (degradationPreference == "disabled") {
-      parameters->SetDegradationPreference(
-          libwebrtc::RTCDegradationPreference::DISABLED);
-    }
+  libwebrtc::RTCDegradationPreference preference;
+  if (!value.IsNull() &&
+      stringToDegradationPreference(GetValue<std::string>(value),
+                                    &preference)) {
+    parameters->SetDegradationPreference(preference);
   }
 
   return parameters;
@@ -750,11 +933,34 @@ void FlutterPeerConnection::RtpSenderSetParameters(
   }
 
   auto param = sender->parameters();
+  const EncodableList& encodings = findList(parameters, "encodings");
+  std::string error = validateEncodings(encodings);
+  if (error.empty() && !encodings.empty() &&
+      encodings.size() != param->encodings().size()) {
+    error = "the number of encodings cannot be changed";
+  }
+  EncodableValue value =
+      findEncodableValue(parameters, "degradationPreference");
+  libwebrtc::RTCDegradationPreference preference;
+  if (error.empty() && !value.IsNull() &&
+      (!TypeIs<std::string>(value) ||
+       !stringToDegradationPreference(GetValue<std::string>(value),
+                                      &preference))) {
+    error = "unknown degradationPreference";
+  }
+  if (!error.empty()) {
+    result_ptr->Error("rtpSenderSetParameters", error);
+    return;
+  }
+
   param = updateRtpParameters(parameters, param);
   bool success = sender->set_parameters(param);
 
   EncodableMap map;
   map[EncodableValue("result")] = EncodableValue(success);
+  // The sender may clamp or ignore some values, so report what took effect.
+  map[EncodableValue("parameters")] =
+      EncodableValue(rtpParametersToMap(sender->parameters()));
   result_ptr->Success(EncodableValue(map));
 }
 
@@ -802,10 +1008,9 @@ void FlutterPeerConnection::SetConfiguration(
 void FlutterPeerConnection::CaptureFrame(
     RTCVideoTrack* track, std::string path,
     std::unique_ptr<MethodResultProxy> result) {
-  // FlutterFrameCapturer capturer(track, path);
-  // capturer.CaptureFrame(std::move(result));
-  std::shared_ptr<MethodResultProxy> result_ptr(result.release());
-  result_ptr->Success();
+  scoped_refptr<FlutterFrameCapturer> capturer =
+      new RefCountedObject<FlutterFrameCapturer>(track, path);
+  capturer->CaptureFrame(std::move(result));
 }
 
 scoped_refptr<RTCRtpTransceiver> FlutterPeerConnection::getRtpTransceiverById(
@@ -1094,7 +1299,7 @@ void FlutterPeerConnectionObserver::OnSignalingState(RTCSignalingState state) {
   EncodableMap params;
   params[EncodableValue("event")] = "signalingState";
   params[EncodableValue("state")] = signalingStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnPeerConnectionState(
@@ -1102,7 +1307,7 @@ void FlutterPeerConnectionObserver::OnPeerConnectionState(
   EncodableMap params;
   params[EncodableValue("event")] = "peerConnectionState";
   params[EncodableValue("state")] = peerConnectionStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnIceGatheringState(
@@ -1110,7 +1315,7 @@ void FlutterPeerConnectionObserver::OnIceGatheringState(
   EncodableMap params;
   params[EncodableValue("event")] = "iceGatheringState";
   params[EncodableValue("state")] = iceGatheringStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnIceConnectionState(
@@ -1118,7 +1323,7 @@ void FlutterPeerConnectionObserver::OnIceConnectionState(
   EncodableMap params;
   params[EncodableValue("event")] = "iceConnectionState";
   params[EncodableValue("state")] = iceConnectionStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnIceCandidate(
@@ -1133,7 +1338,7 @@ void FlutterPeerConnectionObserver::OnIceCandidate(
   cand[EncodableValue("sdpMid")] =
       EncodableValue(candidate->sdp_mid().std_string());
   params[EncodableValue("candidate")] = EncodableValue(cand);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnAddStream(
@@ -1179,7 +1384,7 @@ void FlutterPeerConnectionObserver::OnAddStream(
   remote_streams_[streamId] = scoped_refptr<RTCMediaStream>(stream);
   params[EncodableValue("videoTracks")] = EncodableValue(videoTracks);
 
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnRemoveStream(
@@ -1188,7 +1393,7 @@ void FlutterPeerConnectionObserver::OnRemoveStream(
   params[EncodableValue("event")] = "onRemoveStream";
   params[EncodableValue("streamId")] =
       EncodableValue(stream->label().std_string());
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnAddTrack(
@@ -1217,7 +1422,7 @@ void FlutterPeerConnectionObserver::OnAddTrack(
     audioTrack[EncodableValue("readyState")] = "live";
     params[EncodableValue("track")] = EncodableValue(audioTrack);
 
-    event_channel_->Success(EncodableValue(params));
+    event_channel_->Success(EncodableValue(std::move(params)));
   }
 }
 
@@ -1239,7 +1444,7 @@ void FlutterPeerConnectionObserver::OnTrack(
   params[EncodableValue("transceiver")] =
       EncodableValue(transceiverToMap(transceiver));
 
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnRemoveTrack(
@@ -1252,7 +1457,7 @@ void FlutterPeerConnectionObserver::OnRemoveTrack(
   params[EncodableValue("track")] = EncodableValue(mediaTrackToMap(track));
   params[EncodableValue("receiver")] =
       EncodableValue(rtpReceiverToMap(receiver));
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 // void FlutterPeerConnectionObserver::OnRemoveTrack(
@@ -1273,7 +1478,7 @@ void FlutterPeerConnectionObserver::OnRemoveTrack(
 //    videoTrack[EncodableValue("readyState")] = "live";
 //    params[EncodableValue("track")] = videoTrack;
 //
-//    event_channel_->Success(EncodableValue(params));
+//    event_channel_->Success(EncodableValue(std::move(params)));
 
 //}
 
@@ -1299,13 +1504,13 @@ void FlutterPeerConnectionObserver::OnDataChannel(
   params[EncodableValue("label")] =
       EncodableValue(data_channel->label().std_string());
   params[EncodableValue("flutterId")] = EncodableValue(channel_uuid);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 void FlutterPeerConnectionObserver::OnRenegotiationNeeded() {
   EncodableMap params;
   params[EncodableValue("event")] = "onRenegotiationNeeded";
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(EncodableValue(std::move(params)));
 }
 
 scoped_refptr<RTCMediaStream> FlutterPeerConnectionObserver::MediaStreamForId(
@@ -0,0 +1,441 @@
+#include "flutter_stats_sampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "log.h"
+
+namespace flutter_webrtc_plugin {
+
+static constexpr int64_t kMinSamplingIntervalMs = 100;
+
+// Reads the numeric and string members of a report that the sampler needs.
+static void ReadMembers(MediaRTCStats* report,
+                        std::map<std::string, double>& numbers,
+                        std::map<std::string, std::string>& strings) {
+  auto members = report->Members();
+  for (size_t i = 0; i < members.size(); i++) {
+    auto member = members[i];
+    if (!member->IsDefined()) {
+      continue;
+    }
+    switch (member->GetType()) {
+      case RTCStatsMember::Type::kBool:
+        numbers[member->GetName().std_string()] = member->ValueBool();
+        break;
+      case RTCStatsMember::Type::kInt32:
+        numbers[member->GetName().std_string()] = member->ValueInt32();
+        break;
+      case RTCStatsMember::Type::kUint32:
+        numbers[member->GetName().std_string()] = member->ValueUint32();
+        break;
+      case RTCStatsMember::Type::kInt64:
+        numbers[member->GetName().std_string()] =
+            static_cast<double>(member->ValueInt64());
+        break;
+      case RTCStatsMember::Type::kUint64:
+        numbers[member->GetName().std_string()] =
+            static_cast<double>(member->ValueUint64());
+        break;
+      case RTCStatsMember::Type::kDouble:
+        numbers[member->GetName().std_string()] = member->ValueDouble();
+        break;
+      case RTCStatsMember::Type::kString:
+        strings[member->GetName().std_string()] =
+            member->ValueString().std_string();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+static double GetNumber(const std::map<std::string, double>& numbers,
+                        const std::string& name) {
+  auto it = numbers.find(name);
+  return it != numbers.end() ? it->second : 0;
+}
+
+FlutterStatsSampler::FlutterStatsSampler(scoped_refptr<RTCPeerConnection> pc,
+                                         BinaryMessenger* messenger,
+                                         const std::string& peer_connection_id,
+                                         std::set<std::string> metrics)
+    : pc_(pc),
+      event_channel_(EventChannelProxy::Create(
+          messenger, "FlutterWebRTC/statsEvent" + peer_connection_id)),
+      metrics_(std::move(metrics)) {}
+
+FlutterStatsSampler::~FlutterStatsSampler() { Stop(); }
+
+bool FlutterStatsSampler::Start(int64_t interval_ms) {
+  Stop();
+  timer_ = ecore_timer_add(
+      std::max(interval_ms, kMinSamplingIntervalMs) / 1000.0,
+      [](void* data) -> Eina_Bool {
+        static_cast<FlutterStatsSampler*>(data)->Sample();
+        return ECORE_CALLBACK_RENEW;
+      },
+      this);
+  if (!timer_) {
+    LOG_ERROR("Failed to add a stats sampling timer.");
+    return false;
+  }
+  return true;
+}
+
+void FlutterStatsSampler::Stop() {
+  if (timer_) {
+    ecore_timer_del(timer_);
+    timer_ = nullptr;
+  }
+}
+
+void FlutterStatsSampler::Sample() {
+  // The reports arrive on the signaling thread, possibly after this sampler
+  // has been stopped and released. They are handed over to the platform
+  // thread before the sampler is locked, so that its last reference is never
+  // dropped off the platform thread.
+  std::weak_ptr<FlutterStatsSampler> weak_self = weak_from_this();
+  pc_->GetStats(
+      [weak_self](const vector<scoped_refptr<MediaRTCStats>> reports) {
+        struct PendingStats {
+          std::weak_ptr<FlutterStatsSampler> sampler;
+          vector<scoped_refptr<MediaRTCStats>> reports;
+        };
+        auto* pending = new PendingStats{weak_self, reports};
+        ecore_main_loop_thread_safe_call_async(
+            [](void* data) {
+              auto* pending = static_cast<PendingStats*>(data);
+              if (auto self = pending->sampler.lock()) {
+                self->OnStats(pending->reports);
+              }
+              delete pending;
+            },
+            pending);
+      },
+      [](const char* error) { LOG_ERROR("GetStats failed: %s", error); });
+}
+
+void FlutterStatsSampler::OnStats(
+    const vector<scoped_refptr<MediaRTCStats>>& reports) {
+  EncodableList streams;
+  double rtt_ms = -1;
+  int64_t timestamp_us = 0;
+  for (size_t i = 0; i < reports.size(); i++) {
+    MediaRTCStats* report = reports[i].get();
+    std::string type = report->type().std_string();
+    bool is_inbound = type == "inbound-rtp";
+    bool is_outbound = type == "outbound-rtp";
+    bool is_candidate_pair = type == "candidate-pair";
+    if (!is_inbound && !is_outbound && !is_candidate_pair) {
+      continue;
+    }
+    timestamp_us = std::max(timestamp_us, report->timestamp_us());
+
+    std::map<std::string, double> numbers;
+    std::map<std::string, std::string> strings;
+    ReadMembers(report, numbers, strings);
+
+    if (is_candidate_pair) {
+      if (strings["state"] == "succeeded" && GetNumber(numbers, "nominated") &&
+          numbers.count("currentRoundTripTime") > 0) {
+        rtt_ms = numbers["currentRoundTripTime"] * 1000;
+      }
+      continue;
+    }
+
+    RtpSample sample;
+    sample.timestamp_us = report->timestamp_us();
+    sample.bytes =
+        GetNumber(numbers, is_inbound ? "bytesReceived" : "bytesSent");
+    sample.frames =
+        GetNumber(numbers, is_inbound ? "framesDecoded" : "framesEncoded");
+    sample.packets =
+        GetNumber(numbers, is_inbound ? "packetsReceived" : "packetsSent");
+    sample.packets_lost = GetNumber(numbers, "packetsLost");
+
+    std::string id = report->id().std_string();
+    auto last = last_samples_.find(id);
+    if (last == last_samples_.end()) {
+      // The first sample is only the baseline for the next one.
+      last_samples_[id] = sample;
+      continue;
+    }
+    const RtpSample& previous = last->second;
+    double elapsed_sec = (sample.timestamp_us - previous.timestamp_us) / 1e6;
+    if (elapsed_sec <= 0) {
+      continue;
+    }
+
+    std::string kind = strings["kind"];
+    EncodableMap stream;
+    stream[EncodableValue("ssrc")] =
+        EncodableValue(static_cast<int64_t>(GetNumber(numbers, "ssrc")));
+    stream[EncodableValue("kind")] = EncodableValue(kind);
+    stream[EncodableValue("direction")] =
+        EncodableValue(is_inbound ? "inbound" : "outbound");
+    if (IsSelected("bitrate")) {
+      stream[EncodableValue("bitrate")] =
+          EncodableValue((sample.bytes - previous.bytes) * 8 / elapsed_sec);
+    }
+    if (IsSelected("fps") && kind == "video") {
+      stream[EncodableValue("fps")] =
+          EncodableValue((sample.frames - previous.frames) / elapsed_sec);
+    }
+    if (IsSelected("jitter") && is_inbound) {
+      stream[EncodableValue("jitter")] =
+          EncodableValue(GetNumber(numbers, "jitter") * 1000);
+    }
+    if (IsSelected("packetLoss") && is_inbound) {
+      double lost = sample.packets_lost - previous.packets_lost;
+      double expected = lost + (sample.packets - previous.packets);
+      stream[EncodableValue("packetLoss")] =
+          EncodableValue(expected > 0 ? std::max(lost, 0.0) / expected : 0.0);
+    }
+    streams.push_back(EncodableValue(std::move(stream)));
+    last_samples_[id] = sample;
+  }
+
+  if (streams.empty()) {
+    return;
+  }
+  EncodableMap params;
+  params[EncodableValue("event")] = EncodableValue("statsSample");
+  params[EncodableValue("timestamp")] =
+      EncodableValue(static_cast<double>(timestamp_us) / 1000);
+  params[EncodableValue("streams")] = EncodableValue(std::move(streams));
+  if (IsSelected("rtt") && rtt_ms >= 0) {
+    params[EncodableValue("rtt")] = EncodableValue(rtt_ms);
+  }
+  event_channel_->Success(EncodableValue(std::move(params)), false);
+}
+
+FlutterAudioLevelMonitor::FlutterAudioLevelMonitor(
+    scoped_refptr<RTCPeerConnection> pc, scoped_refptr<RTCRtpSender> sender,
+    scoped_refptr<RTCRtpReceiver> receiver, BinaryMessenger* messenger,
+    const std::string& peer_connection_id, const std::string& track_id)
+    : pc_(pc),
+      sender_(sender),
+      receiver_(receiver),
+      event_channel_(EventChannelProxy::Create(
+          messenger, "FlutterWebRTC/audioLevelEvent" + track_id)),
+      peer_connection_id_(peer_connection_id),
+      track_id_(track_id) {}
+
+FlutterAudioLevelMonitor::~FlutterAudioLevelMonitor() { Stop(); }
+
+bool FlutterAudioLevelMonitor::Start(int64_t interval_ms) {
+  Stop();
+  timer_ = ecore_timer_add(
+      std::max(interval_ms, kMinSamplingIntervalMs) / 1000.0,
+      [](void* data) -> Eina_Bool {
+        static_cast<FlutterAudioLevelMonitor*>(data)->Sample();
+        return ECORE_CALLBACK_RENEW;
+      },
+      this);
+  if (!timer_) {
+    LOG_ERROR("Failed to add an audio level timer.");
+    return false;
+  }
+  return true;
+}
+
+void FlutterAudioLevelMonitor::Stop() {
+  if (timer_) {
+    ecore_timer_del(timer_);
+    timer_ = nullptr;
+  }
+}
+
+void FlutterAudioLevelMonitor::Sample() {
+  // As with the stats sampler, the reports are handed over to the platform
+  // thread before the monitor is locked.
+  std::weak_ptr<FlutterAudioLevelMonitor> weak_self = weak_from_this();
+  auto on_success =
+      [weak_self](const vector<scoped_refptr<MediaRTCStats>> reports) {
+        struct PendingStats {
+          std::weak_ptr<FlutterAudioLevelMonitor> monitor;
+          vector<scoped_refptr<MediaRTCStats>> reports;
+        };
+        auto* pending = new PendingStats{weak_self, reports};
+        ecore_main_loop_thread_safe_call_async(
+            [](void* data) {
+              auto* pending = static_cast<PendingStats*>(data);
+              if (auto self = pending->monitor.lock()) {
+                self->OnStats(pending->reports);
+              }
+              delete pending;
+            },
+            pending);
+      };
+  auto on_failure = [](const char* error) {
+    LOG_ERROR("GetStats failed: %s", error);
+  };
+  if (sender_) {
+    pc_->GetStats(sender_, on_success, on_failure);
+  } else {
+    pc_->GetStats(receiver_, on_success, on_failure);
+  }
+}
+
+void FlutterAudioLevelMonitor::OnStats(
+    const vector<scoped_refptr<MediaRTCStats>>& reports) {
+  for (size_t i = 0; i < reports.size(); i++) {
+    MediaRTCStats* report = reports[i].get();
+    // Local audio is measured at its media source, remote audio at its
+    // inbound RTP stream.
+    std::string type = report->type().std_string();
+    if (type != "media-source" && type != "inbound-rtp") {
+      continue;
+    }
+    std::map<std::string, double> numbers;
+    std::map<std::string, std::string> strings;
+    ReadMembers(report, numbers, strings);
+    if (strings["kind"] != "audio" || numbers.count("totalAudioEnergy") == 0 ||
+        numbers.count("totalSamplesDuration") == 0) {
+      continue;
+    }
+
+    double energy = numbers["totalAudioEnergy"];
+    double duration = numbers["totalSamplesDuration"];
+    bool has_baseline = last_duration_ >= 0;
+    double elapsed = duration - last_duration_;
+    double rms = 0;
+    if (has_baseline && elapsed > 0) {
+      // The energy is the integral of the squared level over time, so its
+      // slope is the mean square level of the interval.
+      rms = std::sqrt(std::max(energy - last_energy_, 0.0) / elapsed);
+    }
+    last_energy_ = energy;
+    last_duration_ = duration;
+    if (!has_baseline) {
+      // The first sample is only the baseline for the next one.
+      return;
+    }
+
+    EncodableMap params;
+    params[EncodableValue("event")] = EncodableValue("audioLevel");
+    params[EncodableValue("trackId")] = EncodableValue(track_id_);
+    params[EncodableValue("timestamp")] =
+        EncodableValue(static_cast<double>(report->timestamp_us()) / 1000);
+    params[EncodableValue("rms")] = EncodableValue(std::min(rms, 1.0));
+    params[EncodableValue("peak")] =
+        EncodableValue(GetNumber(numbers, "audioLevel"));
+    event_channel_->Success(EncodableValue(std::move(params)), false);
+    return;
+  }
+}
+
+void FlutterStatsSampling::StartStatsSampling(
+    const EncodableMap& params, std::unique_ptr<MethodResultProxy> result) {
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = base_->PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("startStatsSamplingFailed",
+                  "startStatsSampling() peerConnection is null");
+    return;
+  }
+  int64_t interval = findLongInt(params, "interval");
+  if (interval <= 0) {
+    interval = 1000;
+  }
+  std::set<std::string> metrics;
+  for (const EncodableValue& metric : findList(params, "metrics")) {
+    if (TypeIs<std::string>(metric)) {
+      metrics.insert(GetValue<std::string>(metric));
+    }
+  }
+
+  auto it = base_->stats_samplers_.find(peerConnectionId);
+  if (it != base_->stats_samplers_.end()) {
+    it->second->Stop();
+    base_->stats_samplers_.erase(it);
+  }
+  auto sampler = std::make_shared<FlutterStatsSampler>(
+      pc, base_->messenger_, peerConnectionId, std::move(metrics));
+  if (!sampler->Start(interval)) {
+    result->Error("startStatsSamplingFailed",
+                  "startStatsSampling() failed to start the timer");
+    return;
+  }
+  base_->stats_samplers_[peerConnectionId] = std::move(sampler);
+  result->Success();
+}
+
+void FlutterStatsSampling::StopStatsSampling(
+    const EncodableMap& params, std::unique_ptr<MethodResultProxy> result) {
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  auto it = base_->stats_samplers_.find(peerConnectionId);
+  if (it != base_->stats_samplers_.end()) {
+    it->second->Stop();
+    base_->stats_samplers_.erase(it);
+  }
+  result->Success();
+}
+
+void FlutterStatsSampling::StartAudioLevelMonitor(
+    const EncodableMap& params, std::unique_ptr<MethodResultProxy> result) {
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = base_->PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("startAudioLevelMonitorFailed",
+                  "startAudioLevelMonitor() peerConnection is null");
+    return;
+  }
+  const std::string trackId = findString(params, "trackId");
+  scoped_refptr<RTCRtpSender> sender;
+  scoped_refptr<RTCRtpReceiver> receiver;
+  for (auto item : pc->senders().std_vector()) {
+    if (item->track() && item->track()->id().std_string() == trackId &&
+        item->track()->kind().std_string() == "audio") {
+      sender = item;
+      break;
+    }
+  }
+  if (!sender) {
+    for (auto item : pc->receivers().std_vector()) {
+      if (item->track() && item->track()->id().std_string() == trackId &&
+          item->track()->kind().std_string() == "audio") {
+        receiver = item;
+        break;
+      }
+    }
+  }
+  if (!sender && !receiver) {
+    result->Error("startAudioLevelMonitorFailed",
+                  "startAudioLevelMonitor() audio track not found");
+    return;
+  }
+  int64_t interval = findLongInt(params, "interval");
+  if (interval <= 0) {
+    interval = 100;
+  }
+
+  auto it = base_->audio_level_monitors_.find(trackId);
+  if (it != base_->audio_level_monitors_.end()) {
+    it->second->Stop();
+    base_->audio_level_monitors_.erase(it);
+  }
+  auto monitor = std::make_shared<FlutterAudioLevelMonitor>(
+      pc, sender, receiver, base_->messenger_, peerConnectionId, trackId);
+  if (!monitor->Start(interval)) {
+    result->Error("startAudioLevelMonitorFailed",
+                  "startAudioLevelMonitor() failed to start the timer");
+    return;
+  }
+  base_->audio_level_monitors_[trackId] = std::move(monitor);
+  result->Success();
+}
+
+void FlutterStatsSampling::StopAudioLevelMonitor(
+    const EncodableMap& params, std::unique_ptr<MethodResultProxy> result) {
+  const std::string trackId = findString(params, "trackId");
+  auto it = base_->audio_level_monitors_.find(trackId);
+  if (it != base_->audio_level_monitors_.end()) {
+    it->second->Stop();
+    base_->audio_level_monitors_.erase(it);
+  }
+  result->Success();
+}
+
+}  // namespace flutter_webrtc_plugin
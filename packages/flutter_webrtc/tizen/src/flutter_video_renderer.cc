@@ -1,43 +1,227 @@
 #include "flutter_video_renderer.h"
 
+#include <Ecore.h>
+
+#include <cstring>
+
+#include "log.h"
+
 namespace flutter_webrtc_plugin {
 
-FlutterVideoRenderer::~FlutterVideoRenderer() {}
+// The maximum rate at which new frames are handed to Flutter, matching the
+// display refresh rate.
+static constexpr int kMaxFramesPerSecond = 60;
+
+bool FlutterVideoRenderer::IsGpuSurfaceSupported() {
+  static bool is_supported = [] {
+    tbm_surface_h surface = tbm_surface_create(16, 16, TBM_FORMAT_NV12);
+    if (!surface) {
+      LOG_WARN("NV12 tbm surfaces are not supported, using pixel buffers.");
+      return false;
+    }
+    tbm_surface_destroy(surface);
+    return true;
+  }();
+  return is_supported;
+}
+
+// The texture must have been unregistered, so that the engine no longer holds
+// any of the surfaces.
+FlutterVideoRenderer::~FlutterVideoRenderer() {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    stopped_ = true;
+    pending_frame_ = nullptr;
+  }
+  pending_cond_.notify_one();
+  if (converter_.joinable()) {
+    converter_.join();
+  }
+  for (ConvertedFrame& buffer : buffers_) {
+    if (buffer.surface) {
+      tbm_surface_destroy(buffer.surface);
+    }
+  }
+}
 
 void FlutterVideoRenderer::initialize(
     TextureRegistrar* registrar, BinaryMessenger* messenger,
-    std::unique_ptr<flutter::TextureVariant> texture, int64_t trxture_id) {
+    std::unique_ptr<flutter::TextureVariant> texture, int64_t trxture_id,
+    bool use_gpu_surface) {
   registrar_ = registrar;
+  use_gpu_surface_ = use_gpu_surface;
   texture_ = std::move(texture);
   texture_id_ = trxture_id;
   std::string channel_name =
       "FlutterWebRTC/Texture" + std::to_string(texture_id_);
   event_channel_ = EventChannelProxy::Create(messenger, channel_name);
+  converter_ = std::thread(&FlutterVideoRenderer::RunConverter, this);
+}
+
+FlutterVideoRenderer::ConvertedFrame* FlutterVideoRenderer::TakeLatestFrame()
+    const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (has_ready_frame_) {
+    std::swap(front_index_, ready_index_);
+    has_ready_frame_ = false;
+    has_front_frame_ = true;
+    frames_rendered_++;
+  }
+  if (!has_front_frame_) {
+    return nullptr;
+  }
+  return &buffers_[front_index_];
 }
 
 const FlutterDesktopPixelBuffer* FlutterVideoRenderer::CopyPixelBuffer(
     size_t width, size_t height) const {
-  mutex_.lock();
-  if (pixel_buffer_.get() && frame_.get()) {
-    if (pixel_buffer_->width != frame_->width() ||
-        pixel_buffer_->height != frame_->height()) {
-      size_t buffer_size =
-          (size_t(frame_->width()) * size_t(frame_->height())) * (32 >> 3);
-      rgb_buffer_.reset(new uint8_t[buffer_size]);
-      pixel_buffer_->width = frame_->width();
-      pixel_buffer_->height = frame_->height();
+  ConvertedFrame* front = TakeLatestFrame();
+  return front ? &front->pixel_buffer : nullptr;
+}
+
+const FlutterDesktopGpuSurfaceDescriptor*
+FlutterVideoRenderer::ObtainGpuSurface(size_t width, size_t height) const {
+  ConvertedFrame* front = TakeLatestFrame();
+  if (!front) {
+    return nullptr;
+  }
+  front->in_use = true;
+  return &front->gpu_surface;
+}
+
+bool FlutterVideoRenderer::ConvertToPixelBuffer(RTCVideoFrame* frame,
+                                                ConvertedFrame& target) {
+  size_t width = static_cast<size_t>(frame->width());
+  size_t height = static_cast<size_t>(frame->height());
+  size_t buffer_size = width * height * (32 >> 3);
+  if (target.capacity < buffer_size) {
+    target.data.reset(new uint8_t[buffer_size]);
+    target.capacity = buffer_size;
+  }
+  frame->ConvertToARGB(RTCVideoFrame::Type::kABGR, target.data.get(), 0,
+                       static_cast<int>(width), static_cast<int>(height));
+  target.pixel_buffer.buffer = target.data.get();
+  target.pixel_buffer.width = width;
+  target.pixel_buffer.height = height;
+  return true;
+}
+
+bool FlutterVideoRenderer::CopyToSurface(RTCVideoFrame* frame,
+                                         ConvertedFrame& target) {
+  if (target.in_use) {
+    // The engine still holds this surface. Drop the frame rather than
+    // overwriting a surface that may be on screen.
+    return false;
+  }
+
+  // NV12 requires even dimensions. The padding of odd-sized frames is filled
+  // by replicating the last column and row.
+  uint32_t width = (static_cast<uint32_t>(frame->width()) + 1) & ~1u;
+  uint32_t height = (static_cast<uint32_t>(frame->height()) + 1) & ~1u;
+  if (target.surface && (target.gpu_surface.width != width ||
+                         target.gpu_surface.height != height)) {
+    tbm_surface_destroy(target.surface);
+    target.surface = nullptr;
+  }
+  if (!target.surface) {
+    target.surface = tbm_surface_create(width, height, TBM_FORMAT_NV12);
+    if (!target.surface) {
+      LOG_ERROR("Failed to create a %ux%u tbm surface.", width, height);
+      return false;
     }
+    target.gpu_surface.handle = target.surface;
+    target.gpu_surface.width = width;
+    target.gpu_surface.height = height;
+    target.gpu_surface.release_context = &target;
+    target.gpu_surface.release_callback = [](void* release_context) {
+      static_cast<ConvertedFrame*>(release_context)->in_use = false;
+    };
+  }
 
-    frame_->ConvertToARGB(RTCVideoFrame::Type::kABGR, rgb_buffer_.get(), 0,
-                          static_cast<int>(pixel_buffer_->width),
-                          static_cast<int>(pixel_buffer_->height));
+  tbm_surface_info_s info;
+  if (tbm_surface_map(target.surface, TBM_SURF_OPTION_WRITE, &info) !=
+      TBM_SURFACE_ERROR_NONE) {
+    LOG_ERROR("Failed to map a tbm surface.");
+    return false;
+  }
+
+  // Copy the luma plane as is and interleave the chroma planes, leaving the
+  // YUV to RGB conversion to the GPU.
+  int frame_width = frame->width();
+  int frame_height = frame->height();
+  const uint8_t* src_y = frame->DataY();
+  uint8_t* dst_y = info.planes[0].ptr;
+  for (int row = 0; row < frame_height; row++) {
+    uint8_t* dst_row = dst_y + row * info.planes[0].stride;
+    memcpy(dst_row, src_y + row * frame->StrideY(), frame_width);
+    if (width > static_cast<uint32_t>(frame_width)) {
+      dst_row[frame_width] = dst_row[frame_width - 1];
+    }
+  }
+  if (height > static_cast<uint32_t>(frame_height)) {
+    memcpy(dst_y + frame_height * info.planes[0].stride,
+           dst_y + (frame_height - 1) * info.planes[0].stride, width);
+  }
+  int chroma_width = (frame_width + 1) / 2;
+  int chroma_height = (frame_height + 1) / 2;
+  for (int row = 0; row < chroma_height; row++) {
+    const uint8_t* src_u = frame->DataU() + row * frame->StrideU();
+    const uint8_t* src_v = frame->DataV() + row * frame->StrideV();
+    uint8_t* dst_uv = info.planes[1].ptr + row * info.planes[1].stride;
+    for (int col = 0; col < chroma_width; col++) {
+      dst_uv[col * 2] = src_u[col];
+      dst_uv[col * 2 + 1] = src_v[col];
+    }
+  }
+  tbm_surface_unmap(target.surface);
+  return true;
+}
+
+void FlutterVideoRenderer::RunConverter() {
+  constexpr auto kMinPublishInterval =
+      std::chrono::microseconds(1000000 / kMaxFramesPerSecond);
+  while (true) {
+    scoped_refptr<RTCVideoFrame> frame;
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      pending_cond_.wait(lock,
+                         [this] { return stopped_ || pending_frame_.get(); });
+      // Wait out the rest of the frame interval. Frames arriving meanwhile
+      // supersede the pending one and are never converted.
+      pending_cond_.wait_until(lock, next_publish_time_,
+                               [this] { return stopped_; });
+      if (stopped_) {
+        break;
+      }
+      frame = pending_frame_;
+      pending_frame_ = nullptr;
+    }
+
+    // Only the converter touches the back buffer, so no lock is needed here.
+    ConvertedFrame& back = buffers_[back_index_];
+    bool converted = use_gpu_surface_ ? CopyToSurface(frame.get(), back)
+                                      : ConvertToPixelBuffer(frame.get(), back);
+    if (!converted) {
+      frames_dropped_++;
+      continue;
+    }
+    next_publish_time_ = std::chrono::steady_clock::now() + kMinPublishInterval;
 
-    pixel_buffer_->buffer = rgb_buffer_.get();
-    mutex_.unlock();
-    return pixel_buffer_.get();
+    bool was_consumed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::swap(back_index_, ready_index_);
+      was_consumed = !has_ready_frame_;
+      has_ready_frame_ = true;
+    }
+    if (was_consumed) {
+      registrar_->MarkTextureFrameAvailable(texture_id_);
+    } else {
+      // The previous frame was replaced before Flutter picked it up. It has
+      // already been marked available, so don't pile up more work.
+      frames_dropped_++;
+    }
   }
-  mutex_.unlock();
-  return nullptr;
 }
 
 void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
@@ -45,10 +229,7 @@ void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
     EncodableMap params;
     params[EncodableValue("event")] = "didFirstFrameRendered";
     params[EncodableValue("id")] = EncodableValue(texture_id_);
-    event_channel_->Success(EncodableValue(params));
-    pixel_buffer_.reset(new FlutterDesktopPixelBuffer());
-    pixel_buffer_->width = 0;
-    pixel_buffer_->height = 0;
+    event_channel_->Success(EncodableValue(std::move(params)));
     first_frame_rendered = true;
   }
   if (rotation_ != frame->rotation()) {
@@ -57,7 +238,7 @@ void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
     params[EncodableValue("id")] = EncodableValue(texture_id_);
     params[EncodableValue("rotation")] =
         EncodableValue((int32_t)frame->rotation());
-    event_channel_->Success(EncodableValue(params));
+    event_channel_->Success(EncodableValue(std::move(params)));
     rotation_ = frame->rotation();
   }
   if (last_frame_size_.width != frame->width() ||
@@ -67,14 +248,30 @@ void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
     params[EncodableValue("id")] = EncodableValue(texture_id_);
     params[EncodableValue("width")] = EncodableValue((int32_t)frame->width());
     params[EncodableValue("height")] = EncodableValue((int32_t)frame->height());
-    event_channel_->Success(EncodableValue(params));
+    event_channel_->Success(EncodableValue(std::move(params)));
 
     last_frame_size_ = {(size_t)frame->width(), (size_t)frame->height()};
   }
-  mutex_.lock();
-  frame_ = frame;
-  mutex_.unlock();
-  registrar_->MarkTextureFrameAvailable(texture_id_);
+  frames_received_++;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (pending_frame_.get()) {
+      frames_dropped_++;
+    }
+    pending_frame_ = frame;
+  }
+  pending_cond_.notify_one();
+}
+
+EncodableMap FlutterVideoRenderer::GetStats() const {
+  EncodableMap stats;
+  stats[EncodableValue("framesReceived")] =
+      EncodableValue(static_cast<int64_t>(frames_received_));
+  stats[EncodableValue("framesRendered")] =
+      EncodableValue(static_cast<int64_t>(frames_rendered_));
+  stats[EncodableValue("framesDropped")] =
+      EncodableValue(static_cast<int64_t>(frames_dropped_));
+  return stats;
 }
 
 void FlutterVideoRenderer::SetVideoTrack(scoped_refptr<RTCVideoTrack> track) {
@@ -108,16 +305,28 @@ FlutterVideoRendererManager::FlutterVideoRendererManager(
 void FlutterVideoRendererManager::CreateVideoRendererTexture(
     std::unique_ptr<MethodResultProxy> result) {
   auto texture = new RefCountedObject<FlutterVideoRenderer>();
-  auto textureVariant =
-      std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
-          [texture](size_t width,
-                    size_t height) -> const FlutterDesktopPixelBuffer* {
-            return texture->CopyPixelBuffer(width, height);
-          }));
+  bool use_gpu_surface = FlutterVideoRenderer::IsGpuSurfaceSupported();
+  std::unique_ptr<flutter::TextureVariant> textureVariant;
+  if (use_gpu_surface) {
+    textureVariant =
+        std::make_unique<flutter::TextureVariant>(flutter::GpuSurfaceTexture(
+            kFlutterDesktopGpuSurfaceTypeNone,
+            [texture](size_t width, size_t height)
+                -> const FlutterDesktopGpuSurfaceDescriptor* {
+              return texture->ObtainGpuSurface(width, height);
+            }));
+  } else {
+    textureVariant =
+        std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
+            [texture](size_t width,
+                      size_t height) -> const FlutterDesktopPixelBuffer* {
+              return texture->CopyPixelBuffer(width, height);
+            }));
+  }
 
   auto texture_id = base_->textures_->RegisterTexture(textureVariant.get());
   texture->initialize(base_->textures_, base_->messenger_,
-                      std::move(textureVariant), texture_id);
+                      std::move(textureVariant), texture_id, use_gpu_surface);
   renderers_[texture_id] = texture;
   EncodableMap params;
   params[EncodableValue("textureId")] = EncodableValue(texture_id);
@@ -154,6 +363,17 @@ void FlutterVideoRendererManager::VideoRendererSetSrcObject(
   }
 }
 
+void FlutterVideoRendererManager::VideoRendererGetStats(
+    int64_t texture_id, std::unique_ptr<MethodResultProxy> result) {
+  auto it = renderers_.find(texture_id);
+  if (it == renderers_.end()) {
+    result->Error("VideoRendererGetStatsFailed",
+                  "VideoRendererGetStats() texture not found!");
+    return;
+  }
+  result->Success(EncodableValue(it->second->GetStats()));
+}
+
 void FlutterVideoRendererManager::VideoRendererDispose(
     int64_t texture_id, std::unique_ptr<MethodResultProxy> result) {
   auto it = renderers_.find(texture_id);
@@ -163,7 +383,17 @@ void FlutterVideoRendererManager::VideoRendererDispose(
     base_->textures_->UnregisterTexture(texture_id,
                                         [&, it] { renderers_.erase(it); });
 #else
-    base_->textures_->UnregisterTexture(texture_id);
+    // The engine may still hold a surface of the renderer until the texture
+    // is unregistered. The renderer is kept alive until then, and released on
+    // the platform thread.
+    auto* renderer = new scoped_refptr<FlutterVideoRenderer>(it->second);
+    base_->textures_->UnregisterTexture(texture_id, [renderer]() {
+      ecore_main_loop_thread_safe_call_async(
+          [](void* data) {
+            delete static_cast<scoped_refptr<FlutterVideoRenderer>*>(data);
+          },
+          renderer);
+    });
     renderers_.erase(it);
 #endif
     result->Success();
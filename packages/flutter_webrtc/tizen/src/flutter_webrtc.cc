@@ -1,5 +1,7 @@
 #include "flutter_webrtc.h"
 
+#include <unordered_map>
+
 #include "log.h"
 
 namespace flutter_webrtc_plugin {
@@ -11,1197 +13,1567 @@ FlutterWebRTC::FlutterWebRTC(FlutterWebRTCPlugin* plugin)
       FlutterMediaStream::FlutterMediaStream(this),
       FlutterPeerConnection::FlutterPeerConnection(this),
       FlutterDataChannel::FlutterDataChannel(this),
-      FlutterFrameCryptor::FlutterFrameCryptor(this) {}
+      FlutterFrameCryptor::FlutterFrameCryptor(this),
+      FlutterStatsSampling::FlutterStatsSampling(this) {}
 
 FlutterWebRTC::~FlutterWebRTC() {}
 
 void FlutterWebRTC::HandleMethodCall(
     const MethodCallProxy& method_call,
     std::unique_ptr<MethodResultProxy> result) {
-  if (method_call.method_name().compare("initialize") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap options = findMap(params, "options");
-    result->Success();
-  } else if (method_call.method_name().compare("createPeerConnection") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap configuration = findMap(params, "configuration");
-    const EncodableMap constraints = findMap(params, "constraints");
-    CreateRTCPeerConnection(configuration, constraints, std::move(result));
-  } else if (method_call.method_name().compare("getUserMedia") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
-    GetUserMedia(constraints, std::move(result));
-  } else if (method_call.method_name().compare("getDisplayMedia") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
-
+  static const std::unordered_map<std::string, MethodHandler> handlers = {
+      {"initialize", &FlutterWebRTC::HandleInitialize},
+      {"createPeerConnection", &FlutterWebRTC::HandleCreatePeerConnection},
+      {"getUserMedia", &FlutterWebRTC::HandleGetUserMedia},
+      {"getDisplayMedia", &FlutterWebRTC::HandleGetDisplayMedia},
+      {"getDesktopSources", &FlutterWebRTC::HandleGetDesktopSources},
+      {"updateDesktopSources", &FlutterWebRTC::HandleUpdateDesktopSources},
+      {"getDesktopSourceThumbnail",
+       &FlutterWebRTC::HandleGetDesktopSourceThumbnail},
+      {"getSources", &FlutterWebRTC::HandleGetSources},
+      {"selectAudioInput", &FlutterWebRTC::HandleSelectAudioInput},
+      {"selectAudioOutput", &FlutterWebRTC::HandleSelectAudioOutput},
+      {"mediaStreamGetTracks", &FlutterWebRTC::HandleMediaStreamGetTracks},
+      {"createOffer", &FlutterWebRTC::HandleCreateOffer},
+      {"createAnswer", &FlutterWebRTC::HandleCreateAnswer},
+      {"addStream", &FlutterWebRTC::HandleAddStream},
+      {"removeStream", &FlutterWebRTC::HandleRemoveStream},
+      {"setLocalDescription", &FlutterWebRTC::HandleSetLocalDescription},
+      {"setRemoteDescription", &FlutterWebRTC::HandleSetRemoteDescription},
+      {"addCandidate", &FlutterWebRTC::HandleAddCandidate},
+      {"getStats", &FlutterWebRTC::HandleGetStats},
+      {"createDataChannel", &FlutterWebRTC::HandleCreateDataChannel},
+      {"dataChannelSend", &FlutterWebRTC::HandleDataChannelSend},
+      {"dataChannelGetBufferedAmount",
+       &FlutterWebRTC::HandleDataChannelGetBufferedAmount},
+      {"dataChannelSetBufferedAmountLowThreshold",
+       &FlutterWebRTC::HandleDataChannelSetBufferedAmountLowThreshold},
+      {"dataChannelClose", &FlutterWebRTC::HandleDataChannelClose},
+      {"streamDispose", &FlutterWebRTC::HandleStreamDispose},
+      {"mediaStreamTrackSetEnable",
+       &FlutterWebRTC::HandleMediaStreamTrackSetEnable},
+      {"trackDispose", &FlutterWebRTC::HandleTrackDispose},
+      {"restartIce", &FlutterWebRTC::HandleRestartIce},
+      {"peerConnectionClose", &FlutterWebRTC::HandlePeerConnectionClose},
+      {"peerConnectionDispose", &FlutterWebRTC::HandlePeerConnectionDispose},
+      {"createVideoRenderer", &FlutterWebRTC::HandleCreateVideoRenderer},
+      {"videoRendererDispose", &FlutterWebRTC::HandleVideoRendererDispose},
+      {"videoRendererGetStats", &FlutterWebRTC::HandleVideoRendererGetStats},
+      {"videoRendererSetSrcObject",
+       &FlutterWebRTC::HandleVideoRendererSetSrcObject},
+      {"mediaStreamTrackSwitchCamera",
+       &FlutterWebRTC::HandleMediaStreamTrackSwitchCamera},
+      {"setVolume", &FlutterWebRTC::HandleSetVolume},
+      {"getLocalDescription", &FlutterWebRTC::HandleGetLocalDescription},
+      {"getRemoteDescription", &FlutterWebRTC::HandleGetRemoteDescription},
+      {"mediaStreamAddTrack", &FlutterWebRTC::HandleMediaStreamAddTrack},
+      {"mediaStreamRemoveTrack", &FlutterWebRTC::HandleMediaStreamRemoveTrack},
+      {"addTrack", &FlutterWebRTC::HandleAddTrack},
+      {"removeTrack", &FlutterWebRTC::HandleRemoveTrack},
+      {"addTransceiver", &FlutterWebRTC::HandleAddTransceiver},
+      {"getTransceivers", &FlutterWebRTC::HandleGetTransceivers},
+      {"getReceivers", &FlutterWebRTC::HandleGetReceivers},
+      {"getSenders", &FlutterWebRTC::HandleGetSenders},
+      {"rtpSenderSetTrack", &FlutterWebRTC::HandleRtpSenderSetTrack},
+      {"rtpSenderSetStreams", &FlutterWebRTC::HandleRtpSenderSetStreams},
+      {"rtpSenderReplaceTrack", &FlutterWebRTC::HandleRtpSenderReplaceTrack},
+      {"rtpSenderSetParameters", &FlutterWebRTC::HandleRtpSenderSetParameters},
+      {"rtpTransceiverStop", &FlutterWebRTC::HandleRtpTransceiverStop},
+      {"rtpTransceiverGetCurrentDirection",
+       &FlutterWebRTC::HandleRtpTransceiverGetCurrentDirection},
+      {"rtpTransceiverSetDirection",
+       &FlutterWebRTC::HandleRtpTransceiverSetDirection},
+      {"setConfiguration", &FlutterWebRTC::HandleSetConfiguration},
+      {"captureFrame", &FlutterWebRTC::HandleCaptureFrame},
+      {"createLocalMediaStream", &FlutterWebRTC::HandleCreateLocalMediaStream},
+      {"canInsertDtmf", &FlutterWebRTC::HandleCanInsertDtmf},
+      {"sendDtmf", &FlutterWebRTC::HandleSendDtmf},
+      {"getRtpSenderCapabilities",
+       &FlutterWebRTC::HandleGetRtpSenderCapabilities},
+      {"getRtpReceiverCapabilities",
+       &FlutterWebRTC::HandleGetRtpReceiverCapabilities},
+      {"setCodecPreferences", &FlutterWebRTC::HandleSetCodecPreferences},
+      {"getSignalingState", &FlutterWebRTC::HandleGetSignalingState},
+      {"getIceGatheringState", &FlutterWebRTC::HandleGetIceGatheringState},
+      {"getIceConnectionState", &FlutterWebRTC::HandleGetIceConnectionState},
+      {"getConnectionState", &FlutterWebRTC::HandleGetConnectionState},
+      {"startStatsSampling", &FlutterWebRTC::HandleStartStatsSampling},
+      {"stopStatsSampling", &FlutterWebRTC::HandleStopStatsSampling},
+      {"startAudioLevelMonitor", &FlutterWebRTC::HandleStartAudioLevelMonitor},
+      {"stopAudioLevelMonitor", &FlutterWebRTC::HandleStopAudioLevelMonitor},
+  };
+  auto it = handlers.find(method_call.method_name());
+  if (it != handlers.end()) {
+    (this->*it->second)(method_call, std::move(result));
+  } else if (HandleFrameCryptorMethodCall(method_call, std::move(result))) {
+    // Do nothing
+  } else {
     result->NotImplemented();
-  } else if (method_call.method_name().compare("getDesktopSources") == 0) {
-    // types: ["screen", "window"]
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  }
+}
 
-    const EncodableList types = findList(params, "types");
-    if (types.empty()) {
-      result->Error("Bad Arguments", "Types is required");
-      return;
-    }
-    result->NotImplemented();
-  } else if (method_call.method_name().compare("updateDesktopSources") == 0) {
-    // types: ["screen", "window"]
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+void FlutterWebRTC::HandleInitialize(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const EncodableMap& options = findMap(params, "options");
+  result->Success();
+}
 
-    const EncodableList types = findList(params, "types");
-    if (types.empty()) {
-      result->Error("Bad Arguments", "Types is required");
-      return;
-    }
+void FlutterWebRTC::HandleCreatePeerConnection(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const EncodableMap& configuration = findMap(params, "configuration");
+  const EncodableMap& constraints = findMap(params, "constraints");
+  CreateRTCPeerConnection(configuration, constraints, std::move(result));
+}
+
+void FlutterWebRTC::HandleGetUserMedia(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const EncodableMap& constraints = findMap(params, "constraints");
+  GetUserMedia(constraints, std::move(result));
+}
+
+void FlutterWebRTC::HandleGetDisplayMedia(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const EncodableMap& constraints = findMap(params, "constraints");
+
+  result->NotImplemented();
+}
+
+void FlutterWebRTC::HandleGetDesktopSources(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  // types: ["screen", "window"]
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Bad arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const EncodableList& types = findList(params, "types");
+  if (types.empty()) {
+    result->Error("Bad Arguments", "Types is required");
+    return;
+  }
+  result->NotImplemented();
+}
+
+void FlutterWebRTC::HandleUpdateDesktopSources(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  // types: ["screen", "window"]
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Bad arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const EncodableList& types = findList(params, "types");
+  if (types.empty()) {
+    result->Error("Bad Arguments", "Types is required");
+    return;
+  }
+  result->NotImplemented();
+}
+
+void FlutterWebRTC::HandleGetDesktopSourceThumbnail(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Bad arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  std::string sourceId = findString(params, "sourceId");
+  if (sourceId.empty()) {
+    result->Error("Bad Arguments", "Incorrect sourceId");
+    return;
+  }
+  const EncodableMap& thumbnailSize = findMap(params, "thumbnailSize");
+  if (!thumbnailSize.empty()) {
     result->NotImplemented();
-  } else if (method_call.method_name().compare("getDesktopSourceThumbnail") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Bad arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  } else {
+    result->Error("Bad Arguments", "Bad arguments received");
+  }
+}
 
-    std::string sourceId = findString(params, "sourceId");
-    if (sourceId.empty()) {
-      result->Error("Bad Arguments", "Incorrect sourceId");
-      return;
-    }
-    const EncodableMap thumbnailSize = findMap(params, "thumbnailSize");
-    if (!thumbnailSize.empty()) {
-      result->NotImplemented();
-    } else {
-      result->Error("Bad Arguments", "Bad arguments received");
-    }
-  } else if (method_call.method_name().compare("getSources") == 0) {
-    GetSources(std::move(result));
-  } else if (method_call.method_name().compare("selectAudioInput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
-    SelectAudioInput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("selectAudioOutput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
-    SelectAudioOutput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamGetTracks") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    MediaStreamGetTracks(streamId, std::move(result));
-  } else if (method_call.method_name().compare("createOffer") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createOfferFailed",
-                    "createOffer() peerConnection is null");
-      return;
-    }
-    CreateOffer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("createAnswer") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createAnswerFailed",
-                    "createAnswer() peerConnection is null");
-      return;
-    }
-    CreateAnswer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("addStream") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (!stream) {
-      result->Error("addStreamFailed", "addStream() stream not found!");
-      return;
-    }
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addStreamFailed", "addStream() peerConnection is null");
-      return;
-    }
-    pc->AddStream(stream);
+void FlutterWebRTC::HandleGetSources(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  GetSources(std::move(result));
+}
+
+void FlutterWebRTC::HandleSelectAudioInput(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string deviceId = findString(params, "deviceId");
+  SelectAudioInput(deviceId, std::move(result));
+}
+
+void FlutterWebRTC::HandleSelectAudioOutput(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string deviceId = findString(params, "deviceId");
+  SelectAudioOutput(deviceId, std::move(result));
+}
+
+void FlutterWebRTC::HandleMediaStreamGetTracks(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string streamId = findString(params, "streamId");
+  MediaStreamGetTracks(streamId, std::move(result));
+}
+
+void FlutterWebRTC::HandleCreateOffer(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "constraints");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("createOfferFailed",
+                  "createOffer() peerConnection is null");
+    return;
+  }
+  CreateOffer(constraints, pc, std::move(result));
+}
+
+void FlutterWebRTC::HandleCreateAnswer(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "constraints");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("createAnswerFailed",
+                  "createAnswer() peerConnection is null");
+    return;
+  }
+  CreateAnswer(constraints, pc, std::move(result));
+}
+
+void FlutterWebRTC::HandleAddStream(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string streamId = findString(params, "streamId");
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+  if (!stream) {
+    result->Error("addStreamFailed", "addStream() stream not found!");
+    return;
+  }
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("addStreamFailed", "addStream() peerConnection is null");
+    return;
+  }
+  pc->AddStream(stream);
+  result->Success();
+}
+
+void FlutterWebRTC::HandleRemoveStream(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string streamId = findString(params, "streamId");
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+  if (!stream) {
+    result->Error("removeStreamFailed", "removeStream() stream not found!");
+    return;
+  }
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("removeStreamFailed",
+                  "removeStream() peerConnection is null");
+    return;
+  }
+  pc->RemoveStream(stream);
+  result->Success();
+}
+
+void FlutterWebRTC::HandleSetLocalDescription(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "description");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("setLocalDescriptionFailed",
+                  "setLocalDescription() peerConnection is null");
+    return;
+  }
+
+  SdpParseError error;
+  scoped_refptr<RTCSessionDescription> description =
+      RTCSessionDescription::Create(findString(constraints, "type").c_str(),
+                                    findString(constraints, "sdp").c_str(),
+                                    &error);
+
+  if (description.get() != nullptr) {
+    SetLocalDescription(description.get(), pc, std::move(result));
+  } else {
+    result->Error("setLocalDescriptionFailed", "Invalid type or sdp");
+  }
+}
+
+void FlutterWebRTC::HandleSetRemoteDescription(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "description");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("setRemoteDescriptionFailed",
+                  "setRemoteDescription() peerConnection is null");
+    return;
+  }
+
+  SdpParseError error;
+  scoped_refptr<RTCSessionDescription> description =
+      RTCSessionDescription::Create(findString(constraints, "type").c_str(),
+                                    findString(constraints, "sdp").c_str(),
+                                    &error);
+
+  if (description.get() != nullptr) {
+    SetRemoteDescription(description.get(), pc, std::move(result));
+  } else {
+    result->Error("setRemoteDescriptionFailed", "Invalid type or sdp");
+  }
+}
+
+void FlutterWebRTC::HandleAddCandidate(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "candidate");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("addCandidateFailed",
+                  "addCandidate() peerConnection is null");
+    return;
+  }
+
+  SdpParseError error;
+  std::string candidate = findString(constraints, "candidate");
+  if (candidate.empty()) {
+    LOG_DEBUG("addCandidate, add end-of-candidates");
     result->Success();
-  } else if (method_call.method_name().compare("removeStream") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (!stream) {
-      result->Error("removeStreamFailed", "removeStream() stream not found!");
-      return;
-    }
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("removeStreamFailed",
-                    "removeStream() peerConnection is null");
-      return;
-    }
-    pc->RemoveStream(stream);
+    return;
+  }
+
+  int sdpMLineIndex = findInt(constraints, "sdpMLineIndex");
+  scoped_refptr<RTCIceCandidate> rtc_candidate = RTCIceCandidate::Create(
+      candidate.c_str(), findString(constraints, "sdpMid").c_str(),
+      sdpMLineIndex == -1 ? 0 : sdpMLineIndex, &error);
+
+  if (rtc_candidate.get() != nullptr) {
+    AddIceCandidate(rtc_candidate.get(), pc, std::move(result));
+  } else {
+    result->Error("addCandidateFailed", "Invalid candidate");
+  }
+}
+
+void FlutterWebRTC::HandleGetStats(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string track_id = findString(params, "trackId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getStatsFailed", "getStats() peerConnection is null");
+    return;
+  }
+  GetStats(track_id, pc, std::move(result));
+}
+
+void FlutterWebRTC::HandleCreateDataChannel(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("createDataChannelFailed",
+                  "createDataChannel() peerConnection is null");
+    return;
+  }
+
+  const std::string label = findString(params, "label");
+  const EncodableMap& dataChannelDict = findMap(params, "dataChannelDict");
+
+  CreateDataChannel(peerConnectionId, label, dataChannelDict, pc,
+                    std::move(result));
+}
+
+void FlutterWebRTC::HandleDataChannelSend(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  // Look the payload up in place; copying the arguments would copy it too.
+  const auto* params =
+      method_call.arguments()
+          ? std::get_if<EncodableMap>(method_call.arguments())
+          : nullptr;
+  if (!params) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const std::string peerConnectionId =
+      findString(*params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("dataChannelSendFailed",
+                  "dataChannelSend() peerConnection is null");
+    return;
+  }
+
+  const std::string dataChannelId = findString(*params, "dataChannelId");
+  const std::string type = findString(*params, "type");
+  auto data = params->find(EncodableValue("data"));
+  FlutterRTCDataChannelObserver* observer =
+      DataChannelObserverForId(dataChannelId);
+  if (observer == nullptr) {
+    result->Error("dataChannelSendFailed",
+                  "dataChannelSend() data_channel is null");
+    return;
+  }
+  if (data == params->end()) {
+    result->Error("dataChannelSendFailed", "dataChannelSend() data is null");
+    return;
+  }
+  DataChannelSend(observer, type, data->second, std::move(result));
+}
+
+void FlutterWebRTC::HandleDataChannelGetBufferedAmount(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string dataChannelId = findString(params, "dataChannelId");
+  FlutterRTCDataChannelObserver* observer =
+      DataChannelObserverForId(dataChannelId);
+  if (observer == nullptr) {
+    result->Error("dataChannelGetBufferedAmountFailed",
+                  "dataChannelGetBufferedAmount() data_channel is null");
+    return;
+  }
+  DataChannelGetBufferedAmount(observer, std::move(result));
+}
+
+void FlutterWebRTC::HandleDataChannelSetBufferedAmountLowThreshold(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string dataChannelId = findString(params, "dataChannelId");
+  FlutterRTCDataChannelObserver* observer =
+      DataChannelObserverForId(dataChannelId);
+  if (observer == nullptr) {
+    result->Error("dataChannelSetBufferedAmountLowThresholdFailed",
+                  "dataChannelSetBufferedAmountLowThreshold() data_channel is "
+                  "null");
+    return;
+  }
+  DataChannelSetBufferedAmountLowThreshold(
+      observer, findLongInt(params, "threshold"), std::move(result));
+}
+
+void FlutterWebRTC::HandleDataChannelClose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("dataChannelCloseFailed",
+                  "dataChannelClose() peerConnection is null");
+    return;
+  }
+
+  const std::string dataChannelId = findString(params, "dataChannelId");
+  RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
+  if (data_channel == nullptr) {
+    result->Error("dataChannelCloseFailed",
+                  "dataChannelClose() data_channel is null");
+    return;
+  }
+  DataChannelClose(data_channel, dataChannelId, std::move(result));
+}
+
+void FlutterWebRTC::HandleStreamDispose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string stream_id = findString(params, "streamId");
+  MediaStreamDispose(stream_id, std::move(result));
+}
+
+void FlutterWebRTC::HandleMediaStreamTrackSetEnable(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string track_id = findString(params, "trackId");
+  const EncodableValue enable = findEncodableValue(params, "enabled");
+  RTCMediaTrack* track = MediaTrackForId(track_id);
+  if (track != nullptr) {
+    track->set_enabled(GetValue<bool>(enable));
+  }
+  result->Success();
+}
+
+void FlutterWebRTC::HandleTrackDispose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string track_id = findString(params, "trackId");
+  MediaStreamTrackDispose(track_id, std::move(result));
+}
+
+void FlutterWebRTC::HandleRestartIce(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("restartIceFailed", "restartIce() peerConnection is null");
+    return;
+  }
+  pc->RestartIce();
+  result->Success();
+}
+
+void FlutterWebRTC::HandlePeerConnectionClose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("peerConnectionCloseFailed",
+                  "peerConnectionClose() peerConnection is null");
+    return;
+  }
+  RTCPeerConnectionClose(pc, peerConnectionId, std::move(result));
+}
+
+void FlutterWebRTC::HandlePeerConnectionDispose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
     result->Success();
-  } else if (method_call.method_name().compare("setLocalDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setLocalDescriptionFailed",
-                    "setLocalDescription() peerConnection is null");
-      return;
-    }
+    return;
+  }
+  RTCPeerConnectionDispose(pc, peerConnectionId, std::move(result));
+}
 
-    SdpParseError error;
-    scoped_refptr<RTCSessionDescription> description =
-        RTCSessionDescription::Create(findString(constraints, "type").c_str(),
-                                      findString(constraints, "sdp").c_str(),
-                                      &error);
+void FlutterWebRTC::HandleCreateVideoRenderer(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  CreateVideoRendererTexture(std::move(result));
+}
 
-    if (description.get() != nullptr) {
-      SetLocalDescription(description.get(), pc, std::move(result));
-    } else {
-      result->Error("setLocalDescriptionFailed", "Invalid type or sdp");
-    }
-  } else if (method_call.method_name().compare("setRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
+void FlutterWebRTC::HandleVideoRendererDispose(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  int64_t texture_id = findLongInt(params, "textureId");
+  VideoRendererDispose(texture_id, std::move(result));
+}
+
+void FlutterWebRTC::HandleVideoRendererGetStats(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  int64_t texture_id = findLongInt(params, "textureId");
+  VideoRendererGetStats(texture_id, std::move(result));
+}
+
+void FlutterWebRTC::HandleVideoRendererSetSrcObject(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string stream_id = findString(params, "streamId");
+  int64_t texture_id = findLongInt(params, "textureId");
+  const std::string owner_tag = findString(params, "ownerTag");
+  const std::string track_id = findString(params, "trackId");
+
+  VideoRendererSetSrcObject(texture_id, stream_id, owner_tag, track_id);
+  result->Success();
+}
+
+void FlutterWebRTC::HandleMediaStreamTrackSwitchCamera(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string track_id = findString(params, "trackId");
+  MediaStreamTrackSwitchCamera(track_id, std::move(result));
+}
+
+void FlutterWebRTC::HandleSetVolume(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+
+}
+
+void FlutterWebRTC::HandleGetLocalDescription(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "description");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("GetLocalDescription",
+                  "GetLocalDescription() peerConnection is null");
+    return;
+  }
+
+  GetLocalDescription(pc, std::move(result));
+}
+
+void FlutterWebRTC::HandleGetRemoteDescription(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& constraints = findMap(params, "description");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("GetRemoteDescription",
+                  "GetRemoteDescription() peerConnection is null");
+    return;
+  }
+
+  GetRemoteDescription(pc, std::move(result));
+}
+
+void FlutterWebRTC::HandleMediaStreamAddTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const std::string streamId = findString(params, "streamId");
+  const std::string trackId = findString(params, "trackId");
+
+  scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+  if (stream == nullptr) {
+    result->Error("MediaStreamAddTrack",
+                  "MediaStreamAddTrack() stream is null");
+    return;
+  }
+
+  scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+  if (track == nullptr) {
+    result->Error("MediaStreamAddTrack",
+                  "MediaStreamAddTrack() track is null");
+    return;
+  }
+
+  MediaStreamAddTrack(stream, track, std::move(result));
+  std::string kind = track->kind().std_string();
+  for (int i = 0; i < renders_.size(); i++) {
+    FlutterVideoRenderer* renderer = renders_.at(i).get();
+    if (renderer->CheckMediaStream(streamId) && 0 == kind.compare("video")) {
+      renderer->SetVideoTrack(static_cast<RTCVideoTrack*>(track.get()));
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setRemoteDescriptionFailed",
-                    "setRemoteDescription() peerConnection is null");
-      return;
+  }
+}
+
+void FlutterWebRTC::HandleMediaStreamRemoveTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const std::string streamId = findString(params, "streamId");
+  const std::string trackId = findString(params, "trackId");
+
+  scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
+  if (stream == nullptr) {
+    result->Error("MediaStreamRemoveTrack",
+                  "MediaStreamRemoveTrack() stream is null");
+    return;
+  }
+
+  scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+  if (track == nullptr) {
+    result->Error("MediaStreamRemoveTrack",
+                  "MediaStreamRemoveTrack() track is null");
+    return;
+  }
+
+  MediaStreamRemoveTrack(stream, track, std::move(result));
+
+  for (int i = 0; i < renders_.size(); i++) {
+    FlutterVideoRenderer* renderer = renders_.at(i).get();
+    if (renderer->CheckVideoTrack(streamId)) {
+      renderer->SetVideoTrack(nullptr);
     }
+  }
+}
+
+void FlutterWebRTC::HandleAddTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string trackId = findString(params, "trackId");
+  const EncodableList& streamIds = findList(params, "streamIds");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("AddTrack", "AddTrack() peerConnection is null");
+    return;
+  }
+
+  scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
+  if (track == nullptr) {
+    result->Error("AddTrack", "AddTrack() track is null");
+    return;
+  }
+  std::vector<std::string> ids;
+  for (EncodableValue value : streamIds) {
+    ids.push_back(GetValue<std::string>(value));
+  }
+
+  AddTrack(pc, track, ids, std::move(result));
+}
+
+void FlutterWebRTC::HandleRemoveTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string senderId = findString(params, "senderId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("removeTrack", "removeTrack() peerConnection is null");
+    return;
+  }
+
+  RemoveTrack(pc, senderId, std::move(result));
+}
+
+void FlutterWebRTC::HandleAddTransceiver(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const EncodableMap& transceiverInit = findMap(params, "transceiverInit");
+  const std::string mediaType = findString(params, "mediaType");
+  const std::string trackId = findString(params, "trackId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("addTransceiver",
+                  "addTransceiver() peerConnection is null");
+    return;
+  }
+  AddTransceiver(pc, trackId, mediaType, transceiverInit, std::move(result));
+}
+
+void FlutterWebRTC::HandleGetTransceivers(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getTransceivers",
+                  "getTransceivers() peerConnection is null");
+    return;
+  }
 
-    SdpParseError error;
-    scoped_refptr<RTCSessionDescription> description =
-        RTCSessionDescription::Create(findString(constraints, "type").c_str(),
-                                      findString(constraints, "sdp").c_str(),
-                                      &error);
+  GetTransceivers(pc, std::move(result));
+}
 
-    if (description.get() != nullptr) {
-      SetRemoteDescription(description.get(), pc, std::move(result));
-    } else {
-      result->Error("setRemoteDescriptionFailed", "Invalid type or sdp");
-    }
-  } else if (method_call.method_name().compare("addCandidate") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "candidate");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addCandidateFailed",
-                    "addCandidate() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleGetReceivers(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    SdpParseError error;
-    std::string candidate = findString(constraints, "candidate");
-    if (candidate.empty()) {
-      LOG_DEBUG("addCandidate, add end-of-candidates");
-      result->Success();
-      return;
-    }
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getReceivers", "getReceivers() peerConnection is null");
+    return;
+  }
 
-    int sdpMLineIndex = findInt(constraints, "sdpMLineIndex");
-    scoped_refptr<RTCIceCandidate> rtc_candidate = RTCIceCandidate::Create(
-        candidate.c_str(), findString(constraints, "sdpMid").c_str(),
-        sdpMLineIndex == -1 ? 0 : sdpMLineIndex, &error);
+  GetReceivers(pc, std::move(result));
+}
 
-    if (rtc_candidate.get() != nullptr) {
-      AddIceCandidate(rtc_candidate.get(), pc, std::move(result));
-    } else {
-      result->Error("addCandidateFailed", "Invalid candidate");
-    }
-  } else if (method_call.method_name().compare("getStats") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string track_id = findString(params, "trackId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getStatsFailed", "getStats() peerConnection is null");
-      return;
-    }
-    GetStats(track_id, pc, std::move(result));
-  } else if (method_call.method_name().compare("createDataChannel") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("createDataChannelFailed",
-                    "createDataChannel() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleGetSenders(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    const std::string label = findString(params, "label");
-    const EncodableMap dataChannelDict = findMap(params, "dataChannelDict");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getSenders", "getSenders() peerConnection is null");
+    return;
+  }
 
-    CreateDataChannel(peerConnectionId, label, dataChannelDict, pc,
-                      std::move(result));
-  } else if (method_call.method_name().compare("dataChannelSend") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("dataChannelSendFailed",
-                    "dataChannelSend() peerConnection is null");
-      return;
-    }
+  GetSenders(pc, std::move(result));
+}
 
-    const std::string dataChannelId = findString(params, "dataChannelId");
-    const std::string type = findString(params, "type");
-    const EncodableValue data = findEncodableValue(params, "data");
-    RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
-    if (data_channel == nullptr) {
-      result->Error("dataChannelSendFailed",
-                    "dataChannelSend() data_channel is null");
-      return;
-    }
-    DataChannelSend(data_channel, type, data, std::move(result));
-  } else if (method_call.method_name().compare("dataChannelClose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("dataChannelCloseFailed",
-                    "dataChannelClose() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleRtpSenderSetTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpSenderSetTrack",
+                  "rtpSenderSetTrack() peerConnection is null");
+    return;
+  }
 
-    const std::string dataChannelId = findString(params, "dataChannelId");
-    RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
-    if (data_channel == nullptr) {
-      result->Error("dataChannelCloseFailed",
-                    "dataChannelClose() data_channel is null");
-      return;
-    }
-    DataChannelClose(data_channel, dataChannelId, std::move(result));
-  } else if (method_call.method_name().compare("streamDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
-    MediaStreamDispose(stream_id, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamTrackSetEnable") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    const EncodableValue enable = findEncodableValue(params, "enabled");
-    RTCMediaTrack* track = MediaTrackForId(track_id);
-    if (track != nullptr) {
-      track->set_enabled(GetValue<bool>(enable));
-    }
-    result->Success();
-  } else if (method_call.method_name().compare("trackDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    MediaStreamTrackDispose(track_id, std::move(result));
-  } else if (method_call.method_name().compare("restartIce") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("restartIceFailed", "restartIce() peerConnection is null");
-      return;
-    }
-    pc->RestartIce();
-    result->Success();
-  } else if (method_call.method_name().compare("peerConnectionClose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("peerConnectionCloseFailed",
-                    "peerConnectionClose() peerConnection is null");
-      return;
-    }
-    RTCPeerConnectionClose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("peerConnectionDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Success();
-      return;
-    }
-    RTCPeerConnectionDispose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("createVideoRenderer") == 0) {
-    CreateVideoRendererTexture(std::move(result));
-  } else if (method_call.method_name().compare("videoRendererDispose") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    int64_t texture_id = findLongInt(params, "textureId");
-    VideoRendererDispose(texture_id, std::move(result));
-  } else if (method_call.method_name().compare("videoRendererSetSrcObject") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
-    int64_t texture_id = findLongInt(params, "textureId");
-    const std::string owner_tag = findString(params, "ownerTag");
-    const std::string track_id = findString(params, "trackId");
-
-    VideoRendererSetSrcObject(texture_id, stream_id, owner_tag, track_id);
-    result->Success();
-  } else if (method_call.method_name().compare(
-                 "mediaStreamTrackSwitchCamera") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    MediaStreamTrackSwitchCamera(track_id, std::move(result));
-  } else if (method_call.method_name().compare("setVolume") == 0) {
-  } else if (method_call.method_name().compare("getLocalDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("GetLocalDescription",
-                    "GetLocalDescription() peerConnection is null");
-      return;
-    }
+  const std::string trackId = findString(params, "trackId");
+  RTCMediaTrack* track = MediaTrackForId(trackId);
 
-    GetLocalDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("getRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("GetRemoteDescription",
-                    "GetRemoteDescription() peerConnection is null");
-      return;
-    }
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+  if (rtpSenderId.empty()) {
+    result->Error("rtpSenderSetTrack",
+                  "rtpSenderSetTrack() rtpSenderId is null or empty");
+    return;
+  }
+  RtpSenderSetTrack(pc, track, rtpSenderId, std::move(result));
+}
 
-    GetRemoteDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamAddTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+void FlutterWebRTC::HandleRtpSenderSetStreams(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpSenderSetStream",
+                  "rtpSenderSetStream() peerConnection is null");
+    return;
+  }
 
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
+  const EncodableList& encodableStreamIds = findList(params, "streamIds");
+  if (encodableStreamIds.empty()) {
+    result->Error("rtpSenderSetStream",
+                  "rtpSenderSetStream() streamId is null or empty");
+    return;
+  }
+  std::vector<std::string> streamIds{};
+  for (EncodableValue value : encodableStreamIds) {
+    streamIds.push_back(GetValue<std::string>(value));
+  }
 
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (stream == nullptr) {
-      result->Error("MediaStreamAddTrack",
-                    "MediaStreamAddTrack() stream is null");
-      return;
-    }
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+  if (rtpSenderId.empty()) {
+    result->Error("rtpSenderSetStream",
+                  "rtpSenderSetStream() rtpSenderId is null or empty");
+    return;
+  }
+  RtpSenderSetStream(pc, streamIds, rtpSenderId, std::move(result));
+}
 
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("MediaStreamAddTrack",
-                    "MediaStreamAddTrack() track is null");
-      return;
-    }
+void FlutterWebRTC::HandleRtpSenderReplaceTrack(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpSenderReplaceTrack",
+                  "rtpSenderReplaceTrack() peerConnection is null");
+    return;
+  }
 
-    MediaStreamAddTrack(stream, track, std::move(result));
-    std::string kind = track->kind().std_string();
-    for (int i = 0; i < renders_.size(); i++) {
-      FlutterVideoRenderer* renderer = renders_.at(i).get();
-      if (renderer->CheckMediaStream(streamId) && 0 == kind.compare("video")) {
-        renderer->SetVideoTrack(static_cast<RTCVideoTrack*>(track.get()));
-      }
-    }
-  } else if (method_call.method_name().compare("mediaStreamRemoveTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  const std::string trackId = findString(params, "trackId");
+  RTCMediaTrack* track = MediaTrackForId(trackId);
 
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+  if (rtpSenderId.empty()) {
+    result->Error("rtpSenderReplaceTrack",
+                  "rtpSenderReplaceTrack() rtpSenderId is null or empty");
+    return;
+  }
+  RtpSenderReplaceTrack(pc, track, rtpSenderId, std::move(result));
+}
 
-    scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
-    if (stream == nullptr) {
-      result->Error("MediaStreamRemoveTrack",
-                    "MediaStreamRemoveTrack() stream is null");
-      return;
-    }
+void FlutterWebRTC::HandleRtpSenderSetParameters(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpSenderSetParameters",
+                  "rtpSenderSetParameters() peerConnection is null");
+    return;
+  }
 
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("MediaStreamRemoveTrack",
-                    "MediaStreamRemoveTrack() track is null");
-      return;
-    }
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+  if (rtpSenderId.empty()) {
+    result->Error("rtpSenderSetParameters",
+                  "rtpSenderSetParameters() rtpSenderId is null or empty");
+    return;
+  }
 
-    MediaStreamRemoveTrack(stream, track, std::move(result));
+  const EncodableMap& parameters = findMap(params, "parameters");
+  if (0 == parameters.size()) {
+    result->Error("rtpSenderSetParameters",
+                  "rtpSenderSetParameters() parameters is null or empty");
+    return;
+  }
 
-    for (int i = 0; i < renders_.size(); i++) {
-      FlutterVideoRenderer* renderer = renders_.at(i).get();
-      if (renderer->CheckVideoTrack(streamId)) {
-        renderer->SetVideoTrack(nullptr);
-      }
-    }
-  } else if (method_call.method_name().compare("addTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  RtpSenderSetParameters(pc, rtpSenderId, parameters, std::move(result));
+}
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string trackId = findString(params, "trackId");
-    const EncodableList streamIds = findList(params, "streamIds");
+void FlutterWebRTC::HandleRtpTransceiverStop(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpTransceiverStop",
+                  "rtpTransceiverStop() peerConnection is null");
+    return;
+  }
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("AddTrack", "AddTrack() peerConnection is null");
-      return;
-    }
+  const std::string transceiverId = findString(params, "transceiverId");
+  if (transceiverId.empty()) {
+    result->Error("rtpTransceiverStop",
+                  "rtpTransceiverStop() transceiverId is null or empty");
+    return;
+  }
 
-    scoped_refptr<RTCMediaTrack> track = MediaTracksForId(trackId);
-    if (track == nullptr) {
-      result->Error("AddTrack", "AddTrack() track is null");
-      return;
-    }
-    std::vector<std::string> ids;
-    for (EncodableValue value : streamIds) {
-      ids.push_back(GetValue<std::string>(value));
-    }
+  RtpTransceiverStop(pc, transceiverId, std::move(result));
+}
 
-    AddTrack(pc, track, ids, std::move(result));
+void FlutterWebRTC::HandleRtpTransceiverGetCurrentDirection(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error(
+        "rtpTransceiverGetCurrentDirection",
+        "rtpTransceiverGetCurrentDirection() peerConnection is null");
+    return;
+  }
 
-  } else if (method_call.method_name().compare("removeTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  const std::string transceiverId = findString(params, "transceiverId");
+  if (transceiverId.empty()) {
+    result->Error("rtpTransceiverGetCurrentDirection",
+                  "rtpTransceiverGetCurrentDirection() transceiverId is "
+                  "null or empty");
+    return;
+  }
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string senderId = findString(params, "senderId");
+  RtpTransceiverGetCurrentDirection(pc, transceiverId, std::move(result));
+}
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("removeTrack", "removeTrack() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleRtpTransceiverSetDirection(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("rtpTransceiverSetDirection",
+                  "rtpTransceiverSetDirection() peerConnection is null");
+    return;
+  }
 
-    RemoveTrack(pc, senderId, std::move(result));
+  const std::string transceiverId = findString(params, "transceiverId");
+  if (transceiverId.empty()) {
+    result->Error("rtpTransceiverSetDirection",
+                  "rtpTransceiverSetDirection() transceiverId is "
+                  "null or empty");
+    return;
+  }
 
-  } else if (method_call.method_name().compare("addTransceiver") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap transceiverInit = findMap(params, "transceiverInit");
-    const std::string mediaType = findString(params, "mediaType");
-    const std::string trackId = findString(params, "trackId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("addTransceiver",
-                    "addTransceiver() peerConnection is null");
-      return;
-    }
-    AddTransceiver(pc, trackId, mediaType, transceiverInit, std::move(result));
-  } else if (method_call.method_name().compare("getTransceivers") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getTransceivers",
-                    "getTransceivers() peerConnection is null");
-      return;
-    }
+  const std::string direction = findString(params, "direction");
+  if (transceiverId.empty()) {
+    result->Error("rtpTransceiverSetDirection",
+                  "rtpTransceiverSetDirection() direction is null or empty");
+    return;
+  }
 
-    GetTransceivers(pc, std::move(result));
-  } else if (method_call.method_name().compare("getReceivers") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getReceivers", "getReceivers() peerConnection is null");
-      return;
-    }
+  RtpTransceiverSetDirection(pc, transceiverId, direction, std::move(result));
+}
 
-    GetReceivers(pc, std::move(result));
+void FlutterWebRTC::HandleSetConfiguration(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("setConfiguration",
+                  "setConfiguration() peerConnection is null");
+    return;
+  }
 
-  } else if (method_call.method_name().compare("getSenders") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getSenders", "getSenders() peerConnection is null");
-      return;
-    }
+  const EncodableMap& configuration = findMap(params, "configuration");
+  if (configuration.empty()) {
+    result->Error("setConfiguration",
+                  "setConfiguration() configuration is null or empty");
+    return;
+  }
+  SetConfiguration(pc, configuration, std::move(result));
+}
 
-    GetSenders(pc, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderSetTrack",
-                    "rtpSenderSetTrack() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleCaptureFrame(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
+  const std::string path = findString(params, "path");
+  if (path.empty()) {
+    result->Error("captureFrame", "captureFrame() path is null or empty");
+    return;
+  }
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (rtpSenderId.empty()) {
-      result->Error("rtpSenderSetTrack",
-                    "rtpSenderSetTrack() rtpSenderId is null or empty");
-      return;
-    }
-    RtpSenderSetTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetStreams") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderSetStream",
-                    "rtpSenderSetStream() peerConnection is null");
-      return;
-    }
+  const std::string trackId = findString(params, "trackId");
+  RTCMediaTrack* track = MediaTrackForId(trackId);
+  if (nullptr == track) {
+    result->Error("captureFrame", "captureFrame() track is null");
+    return;
+  }
+  std::string kind = track->kind().std_string();
+  if (0 != kind.compare("video")) {
+    result->Error("captureFrame", "captureFrame() track not is video track");
+    return;
+  }
+  CaptureFrame(reinterpret_cast<RTCVideoTrack*>(track), path,
+               std::move(result));
+}
 
-    const EncodableList encodableStreamIds = findList(params, "streamIds");
-    if (encodableStreamIds.empty()) {
-      result->Error("rtpSenderSetStream",
-                    "rtpSenderSetStream() streamId is null or empty");
-      return;
-    }
-    std::vector<std::string> streamIds{};
-    for (EncodableValue value : encodableStreamIds) {
-      streamIds.push_back(GetValue<std::string>(value));
-    }
+void FlutterWebRTC::HandleCreateLocalMediaStream(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  CreateLocalMediaStream(std::move(result));
+}
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (rtpSenderId.empty()) {
-      result->Error("rtpSenderSetStream",
-                    "rtpSenderSetStream() rtpSenderId is null or empty");
-      return;
-    }
-    RtpSenderSetStream(pc, streamIds, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderReplaceTrack") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderReplaceTrack",
-                    "rtpSenderReplaceTrack() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleCanInsertDtmf(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("canInsertDtmf", "canInsertDtmf() peerConnection is null");
+    return;
+  }
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
+  auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (rtpSenderId.empty()) {
-      result->Error("rtpSenderReplaceTrack",
-                    "rtpSenderReplaceTrack() rtpSenderId is null or empty");
-      return;
-    }
-    RtpSenderReplaceTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetParameters") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpSenderSetParameters",
-                    "rtpSenderSetParameters() peerConnection is null");
-      return;
-    }
+  if (rtpSender == nullptr) {
+    result->Error("sendDtmf", "sendDtmf() rtpSender is null");
+    return;
+  }
+  auto dtmfSender = rtpSender->dtmf_sender();
+  bool canInsertDtmf = dtmfSender->CanInsertDtmf();
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    if (rtpSenderId.empty()) {
-      result->Error("rtpSenderSetParameters",
-                    "rtpSenderSetParameters() rtpSenderId is null or empty");
-      return;
-    }
+  result->Success(EncodableValue(canInsertDtmf));
+}
 
-    const EncodableMap parameters = findMap(params, "parameters");
-    if (0 == parameters.size()) {
-      result->Error("rtpSenderSetParameters",
-                    "rtpSenderSetParameters() parameters is null or empty");
-      return;
-    }
+void FlutterWebRTC::HandleSendDtmf(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string rtpSenderId = findString(params, "rtpSenderId");
+  const std::string tone = findString(params, "tone");
+  int duration = findInt(params, "duration");
+  int gap = findInt(params, "gap");
+
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("sendDtmf", "sendDtmf() peerConnection is null");
+    return;
+  }
 
-    RtpSenderSetParameters(pc, rtpSenderId, parameters, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverStop") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpTransceiverStop",
-                    "rtpTransceiverStop() peerConnection is null");
-      return;
-    }
+  auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
 
-    const std::string transceiverId = findString(params, "transceiverId");
-    if (transceiverId.empty()) {
-      result->Error("rtpTransceiverStop",
-                    "rtpTransceiverStop() transceiverId is null or empty");
-      return;
-    }
+  if (rtpSender == nullptr) {
+    result->Error("sendDtmf", "sendDtmf() rtpSender is null");
+    return;
+  }
 
-    RtpTransceiverStop(pc, transceiverId, std::move(result));
-  } else if (method_call.method_name().compare(
-                 "rtpTransceiverGetCurrentDirection") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error(
-          "rtpTransceiverGetCurrentDirection",
-          "rtpTransceiverGetCurrentDirection() peerConnection is null");
-      return;
-    }
+  auto dtmfSender = rtpSender->dtmf_sender();
+  dtmfSender->InsertDtmf(tone, duration, gap);
 
-    const std::string transceiverId = findString(params, "transceiverId");
-    if (transceiverId.empty()) {
-      result->Error("rtpTransceiverGetCurrentDirection",
-                    "rtpTransceiverGetCurrentDirection() transceiverId is "
-                    "null or empty");
-      return;
-    }
+  result->Success();
+}
 
-    RtpTransceiverGetCurrentDirection(pc, transceiverId, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverSetDirection") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("rtpTransceiverSetDirection",
-                    "rtpTransceiverSetDirection() peerConnection is null");
-      return;
-    }
+void FlutterWebRTC::HandleGetRtpSenderCapabilities(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  RTCMediaType mediaType = RTCMediaType::AUDIO;
+  const std::string kind = findString(params, "kind");
+  if (0 == kind.compare("video")) {
+    mediaType = RTCMediaType::VIDEO;
+  } else if (0 == kind.compare("audio")) {
+    mediaType = RTCMediaType::AUDIO;
+  } else {
+    result->Error("getRtpSenderCapabilities",
+                  "getRtpSenderCapabilities() kind is null or empty");
+    return;
+  }
+  auto capabilities = factory_->GetRtpSenderCapabilities(mediaType);
+  EncodableMap map;
+  EncodableList codecsList;
+  for (auto codec : capabilities->codecs().std_vector()) {
+    EncodableMap codecMap;
+    codecMap[EncodableValue("mimeType")] =
+        EncodableValue(codec->mime_type().std_string());
+    codecMap[EncodableValue("clockRate")] =
+        EncodableValue(codec->clock_rate());
+    codecMap[EncodableValue("channels")] = EncodableValue(codec->channels());
+    codecMap[EncodableValue("sdpFmtpLine")] =
+        EncodableValue(codec->sdp_fmtp_line().std_string());
+    codecsList.push_back(EncodableValue(codecMap));
+  }
+  map[EncodableValue("codecs")] = EncodableValue(codecsList);
+  map[EncodableValue("headerExtensions")] = EncodableValue(EncodableList());
+  map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
 
-    const std::string transceiverId = findString(params, "transceiverId");
-    if (transceiverId.empty()) {
-      result->Error("rtpTransceiverSetDirection",
-                    "rtpTransceiverSetDirection() transceiverId is "
-                    "null or empty");
-      return;
-    }
+  result->Success(EncodableValue(map));
+}
 
-    const std::string direction = findString(params, "direction");
-    if (transceiverId.empty()) {
-      result->Error("rtpTransceiverSetDirection",
-                    "rtpTransceiverSetDirection() direction is null or empty");
-      return;
-    }
+void FlutterWebRTC::HandleGetRtpReceiverCapabilities(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+
+  RTCMediaType mediaType = RTCMediaType::AUDIO;
+  const std::string kind = findString(params, "kind");
+  if (0 == kind.compare("video")) {
+    mediaType = RTCMediaType::VIDEO;
+  } else if (0 == kind.compare("audio")) {
+    mediaType = RTCMediaType::AUDIO;
+  } else {
+    result->Error("getRtpSenderCapabilities",
+                  "getRtpSenderCapabilities() kind is null or empty");
+    return;
+  }
+  auto capabilities = factory_->GetRtpReceiverCapabilities(mediaType);
+  EncodableMap map;
+  EncodableList codecsList;
+  for (auto codec : capabilities->codecs().std_vector()) {
+    EncodableMap codecMap;
+    codecMap[EncodableValue("mimeType")] =
+        EncodableValue(codec->mime_type().std_string());
+    codecMap[EncodableValue("clockRate")] =
+        EncodableValue(codec->clock_rate());
+    codecMap[EncodableValue("channels")] = EncodableValue(codec->channels());
+    codecMap[EncodableValue("sdpFmtpLine")] =
+        EncodableValue(codec->sdp_fmtp_line().std_string());
+    codecsList.push_back(EncodableValue(codecMap));
+  }
+  map[EncodableValue("codecs")] = EncodableValue(codecsList);
+  map[EncodableValue("headerExtensions")] = EncodableValue(EncodableList());
+  map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
 
-    RtpTransceiverSetDirection(pc, transceiverId, direction, std::move(result));
-  } else if (method_call.method_name().compare("setConfiguration") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setConfiguration",
-                    "setConfiguration() peerConnection is null");
-      return;
-    }
+  result->Success(EncodableValue(map));
+}
 
-    const EncodableMap configuration = findMap(params, "configuration");
-    if (configuration.empty()) {
-      result->Error("setConfiguration",
-                    "setConfiguration() configuration is null or empty");
-      return;
-    }
-    SetConfiguration(pc, configuration, std::move(result));
-  } else if (method_call.method_name().compare("captureFrame") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+void FlutterWebRTC::HandleSetCodecPreferences(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("setCodecPreferences",
+                  "setCodecPreferences() peerConnection is null");
+    return;
+  }
 
-    const std::string path = findString(params, "path");
-    if (path.empty()) {
-      result->Error("captureFrame", "captureFrame() path is null or empty");
-      return;
-    }
+  const std::string transceiverId = findString(params, "transceiverId");
+  if (transceiverId.empty()) {
+    result->Error("setCodecPreferences",
+                  "setCodecPreferences() transceiverId is null or empty");
+    return;
+  }
 
-    const std::string trackId = findString(params, "trackId");
-    RTCMediaTrack* track = MediaTrackForId(trackId);
-    if (nullptr == track) {
-      result->Error("captureFrame", "captureFrame() track is null");
-      return;
-    }
-    std::string kind = track->kind().std_string();
-    if (0 != kind.compare("video")) {
-      result->Error("captureFrame", "captureFrame() track not is video track");
-      return;
-    }
-    CaptureFrame(reinterpret_cast<RTCVideoTrack*>(track), path,
-                 std::move(result));
-
-  } else if (method_call.method_name().compare("createLocalMediaStream") == 0) {
-    CreateLocalMediaStream(std::move(result));
-  } else if (method_call.method_name().compare("canInsertDtmf") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("canInsertDtmf", "canInsertDtmf() peerConnection is null");
-      return;
-    }
+  const EncodableList& codecs = findList(params, "codecs");
+  if (codecs.empty()) {
+    result->Error("Bad Arguments", "Codecs is required");
+    return;
+  }
+  RtpTransceiverSetCodecPreferences(pc, transceiverId, codecs,
+                                    std::move(result));
+}
 
-    auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
+void FlutterWebRTC::HandleGetSignalingState(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
-    if (rtpSender == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() rtpSender is null");
-      return;
-    }
-    auto dtmfSender = rtpSender->dtmf_sender();
-    bool canInsertDtmf = dtmfSender->CanInsertDtmf();
-
-    result->Success(EncodableValue(canInsertDtmf));
-  } else if (method_call.method_name().compare("sendDtmf") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    const std::string tone = findString(params, "tone");
-    int duration = findInt(params, "duration");
-    int gap = findInt(params, "gap");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() peerConnection is null");
-      return;
-    }
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    auto rtpSender = GetRtpSenderById(pc, rtpSenderId);
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getSignalingState",
+                  "getSignalingState() peerConnection is null");
+    return;
+  }
+  EncodableMap state;
+  state[EncodableValue("state")] =
+      signalingStateString(pc->signaling_state());
+  result->Success(EncodableValue(state));
+}
 
-    if (rtpSender == nullptr) {
-      result->Error("sendDtmf", "sendDtmf() rtpSender is null");
-      return;
-    }
+void FlutterWebRTC::HandleGetIceGatheringState(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
-    auto dtmfSender = rtpSender->dtmf_sender();
-    dtmfSender->InsertDtmf(tone, duration, gap);
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    result->Success();
-  } else if (method_call.method_name().compare("getRtpSenderCapabilities") ==
-             0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    RTCMediaType mediaType = RTCMediaType::AUDIO;
-    const std::string kind = findString(params, "kind");
-    if (0 == kind.compare("video")) {
-      mediaType = RTCMediaType::VIDEO;
-    } else if (0 == kind.compare("audio")) {
-      mediaType = RTCMediaType::AUDIO;
-    } else {
-      result->Error("getRtpSenderCapabilities",
-                    "getRtpSenderCapabilities() kind is null or empty");
-      return;
-    }
-    auto capabilities = factory_->GetRtpSenderCapabilities(mediaType);
-    EncodableMap map;
-    EncodableList codecsList;
-    for (auto codec : capabilities->codecs().std_vector()) {
-      EncodableMap codecMap;
-      codecMap[EncodableValue("mimeType")] =
-          EncodableValue(codec->mime_type().std_string());
-      codecMap[EncodableValue("clockRate")] =
-          EncodableValue(codec->clock_rate());
-      codecMap[EncodableValue("channels")] = EncodableValue(codec->channels());
-      codecMap[EncodableValue("sdpFmtpLine")] =
-          EncodableValue(codec->sdp_fmtp_line().std_string());
-      codecsList.push_back(EncodableValue(codecMap));
-    }
-    map[EncodableValue("codecs")] = EncodableValue(codecsList);
-    map[EncodableValue("headerExtensions")] = EncodableValue(EncodableList());
-    map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
-
-    result->Success(EncodableValue(map));
-  } else if (method_call.method_name().compare("getRtpReceiverCapabilities") ==
-             0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-
-    RTCMediaType mediaType = RTCMediaType::AUDIO;
-    const std::string kind = findString(params, "kind");
-    if (0 == kind.compare("video")) {
-      mediaType = RTCMediaType::VIDEO;
-    } else if (0 == kind.compare("audio")) {
-      mediaType = RTCMediaType::AUDIO;
-    } else {
-      result->Error("getRtpSenderCapabilities",
-                    "getRtpSenderCapabilities() kind is null or empty");
-      return;
-    }
-    auto capabilities = factory_->GetRtpReceiverCapabilities(mediaType);
-    EncodableMap map;
-    EncodableList codecsList;
-    for (auto codec : capabilities->codecs().std_vector()) {
-      EncodableMap codecMap;
-      codecMap[EncodableValue("mimeType")] =
-          EncodableValue(codec->mime_type().std_string());
-      codecMap[EncodableValue("clockRate")] =
-          EncodableValue(codec->clock_rate());
-      codecMap[EncodableValue("channels")] = EncodableValue(codec->channels());
-      codecMap[EncodableValue("sdpFmtpLine")] =
-          EncodableValue(codec->sdp_fmtp_line().std_string());
-      codecsList.push_back(EncodableValue(codecMap));
-    }
-    map[EncodableValue("codecs")] = EncodableValue(codecsList);
-    map[EncodableValue("headerExtensions")] = EncodableValue(EncodableList());
-    map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
-
-    result->Success(EncodableValue(map));
-  } else if (method_call.method_name().compare("setCodecPreferences") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("setCodecPreferences",
-                    "setCodecPreferences() peerConnection is null");
-      return;
-    }
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getIceGatheringState",
+                  "getIceGatheringState() peerConnection is null");
+    return;
+  }
+  EncodableMap state;
+  state[EncodableValue("state")] =
+      iceGatheringStateString(pc->ice_gathering_state());
+  result->Success(EncodableValue(state));
+}
 
-    const std::string transceiverId = findString(params, "transceiverId");
-    if (transceiverId.empty()) {
-      result->Error("setCodecPreferences",
-                    "setCodecPreferences() transceiverId is null or empty");
-      return;
-    }
+void FlutterWebRTC::HandleGetIceConnectionState(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
-    const EncodableList codecs = findList(params, "codecs");
-    if (codecs.empty()) {
-      result->Error("Bad Arguments", "Codecs is required");
-      return;
-    }
-    RtpTransceiverSetCodecPreferences(pc, transceiverId, codecs,
-                                      std::move(result));
-  } else if (method_call.method_name().compare("getSignalingState") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getIceConnectionState",
+                  "getIceConnectionState() peerConnection is null");
+    return;
+  }
+  EncodableMap state;
+  state[EncodableValue("state")] =
+      iceConnectionStateString(pc->ice_connection_state());
+  result->Success(EncodableValue(state));
+}
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getSignalingState",
-                    "getSignalingState() peerConnection is null");
-      return;
-    }
-    EncodableMap state;
-    state[EncodableValue("state")] =
-        signalingStateString(pc->signaling_state());
-    result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getIceGatheringState") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+void FlutterWebRTC::HandleGetConnectionState(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+  const std::string peerConnectionId = findString(params, "peerConnectionId");
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getIceGatheringState",
-                    "getIceGatheringState() peerConnection is null");
-      return;
-    }
-    EncodableMap state;
-    state[EncodableValue("state")] =
-        iceGatheringStateString(pc->ice_gathering_state());
-    result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getIceConnectionState") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+  if (pc == nullptr) {
+    result->Error("getConnectionState",
+                  "getConnectionState() peerConnection is null");
+    return;
+  }
+  EncodableMap state;
+  state[EncodableValue("state")] =
+      peerConnectionStateString(pc->peer_connection_state());
+  result->Success(EncodableValue(state));
+}
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+void FlutterWebRTC::HandleStartStatsSampling(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  StartStatsSampling(params, std::move(result));
+}
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getIceConnectionState",
-                    "getIceConnectionState() peerConnection is null");
-      return;
-    }
-    EncodableMap state;
-    state[EncodableValue("state")] =
-        iceConnectionStateString(pc->ice_connection_state());
-    result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getConnectionState") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+void FlutterWebRTC::HandleStopStatsSampling(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  StopStatsSampling(params, std::move(result));
+}
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+void FlutterWebRTC::HandleStartAudioLevelMonitor(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
+  }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  StartAudioLevelMonitor(params, std::move(result));
+}
 
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error("getConnectionState",
-                    "getConnectionState() peerConnection is null");
-      return;
-    }
-    EncodableMap state;
-    state[EncodableValue("state")] =
-        peerConnectionStateString(pc->peer_connection_state());
-    result->Success(EncodableValue(state));
-  } else if (HandleFrameCryptorMethodCall(method_call, std::move(result))) {
-    // Do nothing
-  } else {
-    result->NotImplemented();
+void FlutterWebRTC::HandleStopAudioLevelMonitor(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (!method_call.arguments()) {
+    result->Error("Bad Arguments", "Null constraints arguments received");
+    return;
   }
+  const EncodableMap& params = GetValue<EncodableMap>(*method_call.arguments());
+  StopAudioLevelMonitor(params, std::move(result));
 }
 
 }  // namespace flutter_webrtc_plugin
@@ -156,7 +156,7 @@ scoped_refptr<RTCMediaConstraints> FlutterWebRTCBase::ParseMediaConstraints(
 
   if (constraints.find(EncodableValue("mandatory")) != constraints.end()) {
     auto it = constraints.find(EncodableValue("mandatory"));
-    const EncodableMap mandatory = GetValue<EncodableMap>(it->second);
+    const EncodableMap& mandatory = GetValue<EncodableMap>(it->second);
     ParseConstraints(mandatory, media_constraints, kMandatory);
   } else {
     // Log.d(TAG, "mandatory constraints are not a map");
@@ -208,10 +208,10 @@ bool FlutterWebRTCBase::CreateIceServers(const EncodableList& iceServersArray,
         ice_server.uri = GetValue<std::string>(it->second);
       }
       if (TypeIs<EncodableList>(it->second)) {
-        const EncodableList urls = GetValue<EncodableList>(it->second);
+        const EncodableList& urls = GetValue<EncodableList>(it->second);
         for (auto url : urls) {
           if (TypeIs<EncodableMap>(url)) {
-            const EncodableMap map = GetValue<EncodableMap>(url);
+            const EncodableMap& map = GetValue<EncodableMap>(url);
             std::string value;
             auto it2 = map.find(EncodableValue("url"));
             if (it2 != map.end()) {
@@ -231,7 +231,7 @@ bool FlutterWebRTCBase::ParseRTCConfiguration(const EncodableMap& map,
                                               RTCConfiguration& conf) {
   auto it = map.find(EncodableValue("iceServers"));
   if (it != map.end()) {
-    const EncodableList iceServersArray = GetValue<EncodableList>(it->second);
+    const EncodableList& iceServersArray = GetValue<EncodableList>(it->second);
     CreateIceServers(iceServersArray, conf.ice_servers);
   }
   // iceTransportPolicy (public API)
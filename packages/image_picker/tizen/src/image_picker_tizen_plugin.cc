@@ -9,12 +9,15 @@
 #include <flutter/plugin_registrar.h>
 #include <flutter/standard_method_codec.h>
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "image_resize.h"
+#include "image_resize_task.h"
 #include "permission_manager.h"
 
 namespace {
@@ -59,7 +62,11 @@ class ImagePickerTizenPlugin : public flutter::Plugin {
 
   ImagePickerTizenPlugin() {}
 
-  virtual ~ImagePickerTizenPlugin() {}
+  virtual ~ImagePickerTizenPlugin() {
+    CancelResize();
+    // Waits for the workers of the cancelled tasks.
+    cancelled_tasks_.clear();
+  }
 
  private:
   void HandleMethodCall(
@@ -68,6 +75,7 @@ class ImagePickerTizenPlugin : public flutter::Plugin {
     const auto &method_name = method_call.method_name();
 
     if (result_) {
+      CancelResize();
       SendErrorResult("Already active", "Cancelled by a second request.");
       return;
     }
@@ -220,35 +228,53 @@ class ImagePickerTizenPlugin : public flutter::Plugin {
       return;
     }
 
-    if (count == 0) {
-      self->SendErrorResult("Operation cancelled", "No file selected.");
-    } else if (self->multi_image_) {
-      flutter::EncodableList paths;
-      for (int i = 0; i < count; i++) {
-        std::string source_path = values[i];
-        std::string dest_path;
-        if (self->image_resize_.Resize(source_path, &dest_path)) {
-          paths.push_back(flutter::EncodableValue(dest_path));
-        } else {
-          paths.push_back(flutter::EncodableValue(source_path));
-        }
-        free(values[i]);
-      }
-      self->SendResult(flutter::EncodableValue(paths));
-    } else {
-      std::string source_path = values[0];
-      std::string dest_path;
-      if (self->image_resize_.Resize(source_path, &dest_path)) {
-        self->SendResult(flutter::EncodableValue(dest_path));
-      } else {
-        self->SendResult(flutter::EncodableValue(source_path));
-      }
-      free(values[0]);
+    std::vector<std::string> source_paths;
+    for (int i = 0; i < count; i++) {
+      source_paths.push_back(values[i]);
+      free(values[i]);
     }
-
     if (values) {
       free(values);
     }
+
+    if (source_paths.empty()) {
+      self->SendErrorResult("Operation cancelled", "No file selected.");
+      return;
+    }
+    if (!self->multi_image_) {
+      source_paths.resize(1);
+    }
+
+    // Decoding and encoding take long, so never block the platform thread.
+    self->resize_task_ = ImageResizeTask::Start(
+        self->image_resize_, std::move(source_paths),
+        [self](std::vector<std::string> paths) {
+          self->resize_task_ = nullptr;
+          if (self->multi_image_) {
+            flutter::EncodableList list;
+            for (std::string &path : paths) {
+              list.push_back(flutter::EncodableValue(std::move(path)));
+            }
+            self->SendResult(flutter::EncodableValue(list));
+          } else {
+            self->SendResult(flutter::EncodableValue(paths[0]));
+          }
+        });
+  }
+
+  void CancelResize() {
+    if (resize_task_) {
+      resize_task_->Cancel();
+      cancelled_tasks_.push_back(std::move(resize_task_));
+    }
+    // Destroying a task joins its workers, so only finished tasks are
+    // destroyed here to not block the platform thread.
+    cancelled_tasks_.erase(
+        std::remove_if(cancelled_tasks_.begin(), cancelled_tasks_.end(),
+                       [](const std::shared_ptr<ImageResizeTask> &task) {
+                         return task->IsFinished();
+                       }),
+        cancelled_tasks_.end());
   }
 
   void SendResult(const flutter::EncodableValue &result) {
@@ -270,6 +296,9 @@ class ImagePickerTizenPlugin : public flutter::Plugin {
 
   std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result_;
   ImageResize image_resize_;
+  std::shared_ptr<ImageResizeTask> resize_task_;
+  // Cancelled tasks whose workers may still be running.
+  std::vector<std::shared_ptr<ImageResizeTask>> cancelled_tasks_;
   bool multi_image_ = false;
 };
 
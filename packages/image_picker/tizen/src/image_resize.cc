@@ -8,9 +8,125 @@
 #include <app_common.h>
 
 #include <algorithm>
+#include <fstream>
+#include <utility>
 
 #include "log.h"
 
+namespace {
+
+// Reads the dimensions of a JPEG image from its SOF (start of frame) segment
+// without decoding it. Returns false if the file is not a JPEG image.
+bool ReadJpegSize(const std::string& path, uint32_t* width, uint32_t* height) {
+  std::ifstream file(path, std::ios::binary);
+  if (file.get() != 0xff || file.get() != 0xd8) {
+    return false;
+  }
+  while (file) {
+    if (file.get() != 0xff) {
+      return false;
+    }
+    int marker = file.get();
+    while (marker == 0xff) {
+      marker = file.get();
+    }
+    if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd7)) {
+      // Standalone markers without a length.
+      continue;
+    }
+    if (marker < 0 || marker == 0xd9 || marker == 0xda) {
+      // End of image or start of scan before any frame header.
+      return false;
+    }
+    int length = file.get() << 8;
+    length |= file.get();
+    if (!file || length < 2) {
+      return false;
+    }
+    bool is_sof = marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 &&
+                  marker != 0xc8 && marker != 0xcc;
+    if (is_sof) {
+      unsigned char header[5];
+      if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+      }
+      *height = (header[1] << 8) | header[2];
+      *width = (header[3] << 8) | header[4];
+      return *width > 0 && *height > 0;
+    }
+    file.seekg(length - 2, std::ios::cur);
+  }
+  return false;
+}
+
+}  // namespace
+
+void ImageResize::GetTargetSize(uint32_t original_width,
+                                uint32_t original_height, uint32_t* width,
+                                uint32_t* height) {
+  bool has_max_width = max_width_ != 0;
+  bool has_max_height = max_height_ != 0;
+
+  *width =
+      has_max_width ? std::min(original_width, max_width_) : original_width;
+  *height =
+      has_max_height ? std::min(original_height, max_height_) : original_height;
+
+  bool should_downscale_width = has_max_width && max_width_ < original_width;
+  bool should_downscale_height =
+      has_max_height && max_height_ < original_height;
+
+  if (should_downscale_width || should_downscale_height) {
+    uint32_t downscaled_width =
+        (*height / static_cast<float>(original_height)) * original_width;
+    uint32_t downscaled_height =
+        (*width / static_cast<float>(original_width)) * original_height;
+
+    if (*width < *height) {
+      if (!has_max_width) {
+        *width = downscaled_width;
+      } else {
+        *height = downscaled_height;
+      }
+    } else if (*height < *width) {
+      if (!has_max_height) {
+        *height = downscaled_height;
+      } else {
+        *width = downscaled_width;
+      }
+    } else {
+      if (original_width < original_height) {
+        *width = downscaled_width;
+      } else if (original_height < original_width) {
+        *height = downscaled_height;
+      }
+    }
+  }
+}
+
+image_util_scale_e ImageResize::GetJpegDownscale(uint32_t width,
+                                                 uint32_t height) {
+  uint32_t target_width, target_height;
+  GetTargetSize(width, height, &target_width, &target_height);
+  if (target_width >= width && target_height >= height) {
+    return IMAGE_UTIL_DOWNSCALE_1_1;
+  }
+
+  // The largest factor that still decodes at least the target size, so that
+  // the final resample in TransformImage() only scales down.
+  constexpr std::pair<uint32_t, image_util_scale_e> kScales[] = {
+      {8, IMAGE_UTIL_DOWNSCALE_1_8},
+      {4, IMAGE_UTIL_DOWNSCALE_1_4},
+      {2, IMAGE_UTIL_DOWNSCALE_1_2},
+  };
+  for (const auto& [factor, scale] : kScales) {
+    if (width / factor >= target_width && height / factor >= target_height) {
+      return scale;
+    }
+  }
+  return IMAGE_UTIL_DOWNSCALE_1_1;
+}
+
 bool ImageResize::DecodeImage(const std::string& path,
                               image_util_image_h* image) {
   image_util_decode_h handle = nullptr;
@@ -28,6 +144,22 @@ bool ImageResize::DecodeImage(const std::string& path,
     return false;
   }
 
+  uint32_t width = 0, height = 0;
+  bool has_max_size = max_width_ != 0 || max_height_ != 0;
+  if (has_max_size && ReadJpegSize(path, &width, &height)) {
+    // Lets the JPEG decoder skip DCT coefficients instead of decoding the full
+    // resolution image only to scale it down.
+    image_util_scale_e scale = GetJpegDownscale(width, height);
+    if (scale != IMAGE_UTIL_DOWNSCALE_1_1) {
+      LOG_DEBUG("Decoding %u x %u image with downscale %d", width, height,
+                scale);
+      ret = image_util_decode_set_jpeg_downscale(handle, scale);
+      if (ret != IMAGE_UTIL_ERROR_NONE) {
+        LOG_WARN("Failed to set downscale: %s", get_error_message(ret));
+      }
+    }
+  }
+
   ret = image_util_decode_run2(handle, image);
   if (ret != IMAGE_UTIL_ERROR_NONE) {
     LOG_ERROR("Failed to decode image: %s", get_error_message(ret));
@@ -59,44 +191,8 @@ bool ImageResize::TransformImage(image_util_image_h input,
     return false;
   }
 
-  bool has_max_width = max_width_ != 0;
-  bool has_max_height = max_height_ != 0;
-
-  uint32_t width =
-      has_max_width ? std::min(original_width, max_width_) : original_width;
-  uint32_t height =
-      has_max_height ? std::min(original_height, max_height_) : original_height;
-
-  bool should_downscale_width = has_max_width && max_width_ < original_width;
-  bool should_downscale_height =
-      has_max_height && max_height_ < original_height;
-
-  if (should_downscale_width || should_downscale_height) {
-    uint32_t downscaled_width =
-        (height / static_cast<float>(original_height)) * original_width;
-    uint32_t downscaled_height =
-        (width / static_cast<float>(original_width)) * original_height;
-
-    if (width < height) {
-      if (!has_max_width) {
-        width = downscaled_width;
-      } else {
-        height = downscaled_height;
-      }
-    } else if (height < width) {
-      if (!has_max_height) {
-        height = downscaled_height;
-      } else {
-        width = downscaled_width;
-      }
-    } else {
-      if (original_width < original_height) {
-        width = downscaled_width;
-      } else if (original_height < original_width) {
-        height = downscaled_height;
-      }
-    }
-  }
+  uint32_t width, height;
+  GetTargetSize(original_width, original_height, &width, &height);
 
   LOG_DEBUG("Target image resolution: %d x %d", width, height);
   ret = image_util_transform_set_resolution(handle, width, height);
@@ -172,6 +268,7 @@ bool ImageResize::EncodeImage(image_util_image_h image,
 }
 
 bool ImageResize::Resize(const std::string& source_path,
+                         const std::string& dest_prefix,
                          std::string* dest_path) {
   bool should_scale = max_width_ != 0 || max_height_ != 0 || IsValidQuality();
   if (!should_scale) {
@@ -196,7 +293,7 @@ bool ImageResize::Resize(const std::string& source_path,
 
   size_t pos = source_path.rfind("/");
   if (pos != std::string::npos) {
-    *dest_path += "scaled_" + source_path.substr(pos + 1);
+    *dest_path += dest_prefix + source_path.substr(pos + 1);
   } else {
     image_util_destroy_image(image);
     return false;
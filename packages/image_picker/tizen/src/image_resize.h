@@ -20,11 +20,21 @@ class ImageResize {
     quality_ = quality;
   }
 
-  bool Resize(const std::string& input_path, std::string* output_path);
+  // Writes the resized image to the cache directory, named |output_prefix|
+  // followed by the input file name.
+  bool Resize(const std::string& input_path, const std::string& output_prefix,
+              std::string* output_path);
 
  private:
   bool IsValidQuality() { return quality_ > 0 && quality_ < 100; }
 
+  // Computes the size that an image of the given size is resized to.
+  void GetTargetSize(uint32_t original_width, uint32_t original_height,
+                     uint32_t* width, uint32_t* height);
+
+  // Returns the JPEG decoder scale for an image of the given size.
+  image_util_scale_e GetJpegDownscale(uint32_t width, uint32_t height);
+
   bool DecodeImage(const std::string& path, image_util_image_h* image);
 
   bool TransformImage(image_util_image_h input, image_util_image_h* output);
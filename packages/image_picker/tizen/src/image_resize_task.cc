@@ -0,0 +1,123 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "image_resize_task.h"
+
+#include <Ecore.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "log.h"
+
+namespace {
+
+// Each worker holds a full resolution decoded image and its resized copy, so
+// the number of workers is bounded by memory rather than by CPU cores.
+constexpr size_t kMaxWorkers = 2;
+
+}  // namespace
+
+std::shared_ptr<ImageResizeTask> ImageResizeTask::Start(
+    const ImageResize& image_resize, std::vector<std::string> source_paths,
+    OnComplete on_complete) {
+  auto task = std::make_shared<ImageResizeTask>(
+      image_resize, std::move(source_paths), std::move(on_complete));
+
+  size_t workers = std::max(std::thread::hardware_concurrency(), 1u);
+  workers = std::min({workers, kMaxWorkers, task->source_paths_.size()});
+  LOG_DEBUG("Resizing %zu images with %zu threads.",
+            task->source_paths_.size(), workers);
+  if (workers == 0) {
+    task->Complete();
+    return task;
+  }
+  task->running_workers_ = workers;
+  task->workers_.reserve(workers);
+  for (size_t i = 0; i < workers; i++) {
+    // The task joins its workers before it is destroyed.
+    ImageResizeTask* self = task.get();
+    task->workers_.emplace_back([self]() {
+      self->Run();
+      self->exited_workers_++;
+    });
+  }
+  return task;
+}
+
+ImageResizeTask::ImageResizeTask(const ImageResize& image_resize,
+                                 std::vector<std::string> source_paths,
+                                 OnComplete on_complete)
+    : image_resize_(image_resize),
+      source_paths_(std::move(source_paths)),
+      result_paths_(source_paths_),
+      on_complete_(std::move(on_complete)) {}
+
+ImageResizeTask::~ImageResizeTask() {
+  cancelled_ = true;
+  for (std::thread& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  RemoveOutputs();
+}
+
+void ImageResizeTask::Run() {
+  while (!cancelled_) {
+    size_t index = next_index_++;
+    if (index >= source_paths_.size()) {
+      break;
+    }
+    // Different source directories may contain files with the same name.
+    std::string prefix = "scaled_" + std::to_string(index) + "_";
+    std::string dest_path;
+    if (image_resize_.Resize(source_paths_[index], prefix, &dest_path)) {
+      result_paths_[index] = dest_path;
+    }
+  }
+
+  if (--running_workers_ > 0) {
+    return;
+  }
+  // The last worker hands the task over to the platform thread. The task may
+  // already be being destroyed, in which case there is nothing to report.
+  std::shared_ptr<ImageResizeTask> self = weak_from_this().lock();
+  if (!self) {
+    return;
+  }
+  auto* task = new std::shared_ptr<ImageResizeTask>(std::move(self));
+  ecore_main_loop_thread_safe_call_async(
+      [](void* data) {
+        auto* task = static_cast<std::shared_ptr<ImageResizeTask>*>(data);
+        (*task)->Complete();
+        delete task;
+      },
+      task);
+}
+
+void ImageResizeTask::Complete() {
+  if (cancelled_) {
+    RemoveOutputs();
+    return;
+  }
+  if (!on_complete_) {
+    return;
+  }
+  OnComplete on_complete = std::move(on_complete_);
+  std::vector<std::string> paths;
+  paths.swap(result_paths_);
+  on_complete(std::move(paths));
+}
+
+void ImageResizeTask::RemoveOutputs() {
+  for (size_t i = 0; i < result_paths_.size(); i++) {
+    if (result_paths_[i] != source_paths_[i]) {
+      if (std::remove(result_paths_[i].c_str()) != 0) {
+        LOG_WARN("Failed to delete %s.", result_paths_[i].c_str());
+      }
+      result_paths_[i] = source_paths_[i];
+    }
+  }
+}
@@ -0,0 +1,69 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_IMAGE_RESIZE_TASK_H_
+#define FLUTTER_PLUGIN_IMAGE_RESIZE_TASK_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "image_resize.h"
+
+// Resizes a list of images on up to two worker threads, and reports the
+// resulting paths in the original order on the platform thread.
+//
+// The worker threads are joined when the task is destroyed, which must happen
+// on the platform thread.
+class ImageResizeTask : public std::enable_shared_from_this<ImageResizeTask> {
+ public:
+  // Called with the path of the resized image, or the source path if the
+  // image is not resized, for each source path.
+  using OnComplete = std::function<void(std::vector<std::string> paths)>;
+
+  // Must be called on the platform thread.
+  static std::shared_ptr<ImageResizeTask> Start(
+      const ImageResize& image_resize, std::vector<std::string> source_paths,
+      OnComplete on_complete);
+
+  ImageResizeTask(const ImageResize& image_resize,
+                  std::vector<std::string> source_paths,
+                  OnComplete on_complete);
+  // Cancels the task and waits for the worker threads to finish. The resized
+  // images are deleted unless they have been reported.
+  ~ImageResizeTask();
+
+  // Must be called on the platform thread. |on_complete| is never called
+  // afterwards, the images not yet started are skipped, and the resized images
+  // are deleted.
+  void Cancel() { cancelled_ = true; }
+
+  // Whether all worker threads have finished, so that destroying the task
+  // doesn't block.
+  bool IsFinished() const { return exited_workers_ == workers_.size(); }
+
+ private:
+  // Runs on a worker thread.
+  void Run();
+  // Runs on the platform thread.
+  void Complete();
+  // Deletes the resized images. Must not be called while workers are
+  // resizing.
+  void RemoveOutputs();
+
+  ImageResize image_resize_;
+  std::vector<std::string> source_paths_;
+  std::vector<std::string> result_paths_;
+  OnComplete on_complete_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_index_ = 0;
+  std::atomic<size_t> running_workers_ = 0;
+  std::atomic<size_t> exited_workers_ = 0;
+  std::atomic<bool> cancelled_ = false;
+};
+
+#endif  // FLUTTER_PLUGIN_IMAGE_RESIZE_TASK_H_
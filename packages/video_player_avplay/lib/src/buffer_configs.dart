@@ -0,0 +1,90 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/// Predefined buffering profiles.
+enum BufferingPreset {
+  /// Small buffers for low-latency live streams.
+  lowLatency,
+
+  /// The middle ground between latency and robustness.
+  balanced,
+
+  /// Deep buffers for VOD over unreliable networks.
+  resilient,
+}
+
+/// Buffering configurations for the player.
+///
+/// Values set explicitly take precedence over the values of [preset]. Fields
+/// left null keep the player's defaults (or the preset's values, if any).
+///
+/// Only applies to network streams played by PlusPlayer.
+class BufferConfigs {
+  /// Creates a new [BufferConfigs].
+  const BufferConfigs({
+    this.preset,
+    this.maxBufferSize,
+    this.maxBufferDuration,
+    this.initialBufferDuration,
+    this.rebufferDuration,
+    this.bufferingTimeout,
+  });
+
+  /// Creates a [BufferConfigs] from the effective values reported by the
+  /// platform.
+  factory BufferConfigs.fromMap(Map<Object?, Object?> map) {
+    Duration? toDuration(Object? value) =>
+        value is int ? Duration(milliseconds: value) : null;
+
+    return BufferConfigs(
+      maxBufferSize: map['maxBufferSize'] as int?,
+      maxBufferDuration: toDuration(map['maxBufferDuration']),
+      initialBufferDuration: toDuration(map['initialBufferDuration']),
+      rebufferDuration: toDuration(map['rebufferDuration']),
+      bufferingTimeout: toDuration(map['bufferingTimeout']),
+    );
+  }
+
+  /// The buffering profile to start from.
+  final BufferingPreset? preset;
+
+  /// The maximum size of the stream buffer, in bytes.
+  final int? maxBufferSize;
+
+  /// The maximum duration of media kept in the stream buffer.
+  final Duration? maxBufferDuration;
+
+  /// The amount of media that must be buffered before the playback starts.
+  final Duration? initialBufferDuration;
+
+  /// The amount of media that must be buffered before the playback resumes
+  /// after a rebuffering.
+  final Duration? rebufferDuration;
+
+  /// How long the player waits for the initial buffering to complete.
+  final Duration? bufferingTimeout;
+
+  /// Converts to a map.
+  Map<String, Object?> toMap() {
+    return <String, Object?>{
+      'preset': preset?.name,
+      'maxBufferSize': maxBufferSize,
+      'maxBufferDuration': maxBufferDuration?.inMilliseconds,
+      'initialBufferDuration': initialBufferDuration?.inMilliseconds,
+      'rebufferDuration': rebufferDuration?.inMilliseconds,
+      'bufferingTimeout': bufferingTimeout?.inMilliseconds,
+    };
+  }
+
+  @override
+  String toString() {
+    return 'BufferConfigs('
+        'preset: $preset, '
+        'maxBufferSize: $maxBufferSize, '
+        'maxBufferDuration: $maxBufferDuration, '
+        'initialBufferDuration: $initialBufferDuration, '
+        'rebufferDuration: $rebufferDuration, '
+        'bufferingTimeout: $bufferingTimeout)';
+  }
+}
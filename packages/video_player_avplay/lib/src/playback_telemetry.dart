@@ -0,0 +1,112 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/// A sample of the buffer level at a point in time.
+class BufferLevelSample {
+  /// Creates a new [BufferLevelSample].
+  const BufferLevelSample(this.time, this.percent);
+
+  /// The time since the player was created.
+  final Duration time;
+
+  /// The buffer level, in percent.
+  final int percent;
+
+  @override
+  String toString() => 'BufferLevelSample(time: $time, percent: $percent)';
+}
+
+/// A periodic summary of the playback quality of experience.
+///
+/// Summaries are only reported if `telemetryInterval` (in milliseconds) is
+/// set in the player options.
+class PlaybackTelemetry {
+  /// Creates a new [PlaybackTelemetry].
+  const PlaybackTelemetry({
+    this.prepareTime,
+    this.drmTime,
+    this.firstFrameTime,
+    this.bitrate = 0,
+    this.bitrateSwitches = 0,
+    this.bufferLevel = 0,
+    this.bufferLevels = const <BufferLevelSample>[],
+    this.rebufferCount = 0,
+    this.rebufferDuration = Duration.zero,
+  });
+
+  /// Creates a [PlaybackTelemetry] from the summary reported by the platform.
+  factory PlaybackTelemetry.fromMap(Map<Object?, Object?> map) {
+    Duration? toDuration(Object? value) =>
+        value is int ? Duration(milliseconds: value) : null;
+
+    final Map<Object?, Object?> startup =
+        map['startup'] as Map<Object?, Object?>? ?? <Object?, Object?>{};
+    final List<Object?> bufferLevels =
+        map['bufferLevels'] as List<Object?>? ?? <Object?>[];
+
+    return PlaybackTelemetry(
+      prepareTime: toDuration(startup['prepare']),
+      drmTime: toDuration(startup['drm']),
+      firstFrameTime: toDuration(startup['firstFrame']),
+      bitrate: map['bitrate'] as int? ?? 0,
+      bitrateSwitches: map['bitrateSwitches'] as int? ?? 0,
+      bufferLevel: map['bufferLevel'] as int? ?? 0,
+      bufferLevels: <BufferLevelSample>[
+        for (final Object? sample in bufferLevels)
+          BufferLevelSample(
+            Duration(milliseconds: (sample! as List<Object?>)[0]! as int),
+            sample[1]! as int,
+          ),
+      ],
+      rebufferCount: map['rebufferCount'] as int? ?? 0,
+      rebufferDuration: toDuration(map['rebufferDuration']) ?? Duration.zero,
+    );
+  }
+
+  /// The time from the player creation until the player is prepared.
+  final Duration? prepareTime;
+
+  /// The time taken to acquire the first DRM license.
+  final Duration? drmTime;
+
+  /// The time from the first play request until the playback starts.
+  ///
+  /// This is null if the player can't report when the first frame is
+  /// rendered, which is the case for assets and local files.
+  final Duration? firstFrameTime;
+
+  /// The current bitrate of the stream, in bits per second.
+  ///
+  /// This is 0 if the player hasn't reported a bitrate.
+  final int bitrate;
+
+  /// The number of bitrate (variant) switches so far.
+  final int bitrateSwitches;
+
+  /// The latest buffer level, in percent.
+  final int bufferLevel;
+
+  /// The buffer level samples since the previous summary.
+  final List<BufferLevelSample> bufferLevels;
+
+  /// The number of rebufferings after the playback started.
+  final int rebufferCount;
+
+  /// The total time spent rebuffering after the playback started.
+  final Duration rebufferDuration;
+
+  @override
+  String toString() {
+    return 'PlaybackTelemetry('
+        'prepareTime: $prepareTime, '
+        'drmTime: $drmTime, '
+        'firstFrameTime: $firstFrameTime, '
+        'bitrate: $bitrate, '
+        'bitrateSwitches: $bitrateSwitches, '
+        'bufferLevel: $bufferLevel, '
+        'bufferLevels: $bufferLevels, '
+        'rebufferCount: $rebufferCount, '
+        'rebufferDuration: $rebufferDuration)';
+  }
+}
@@ -7,13 +7,17 @@ import 'package:flutter/services.dart';
 import 'package:flutter/widgets.dart';
 
 import '../video_player_platform_interface.dart';
+import 'buffer_configs.dart';
 import 'messages.g.dart';
+import 'playback_telemetry.dart';
 import 'tracks.dart';
 
 /// An implementation of [VideoPlayerPlatform] that uses the
 /// Pigeon-generated [VideoPlayerAvplayApi].
 class VideoPlayerTizen extends VideoPlayerPlatform {
   final VideoPlayerAvplayApi _api = VideoPlayerAvplayApi();
+  final MethodChannel _thumbnailChannel =
+      const MethodChannel('tizen/video_player/thumbnail');
 
   @override
   Future<void> init() {
@@ -38,7 +42,12 @@ class VideoPlayerTizen extends VideoPlayerPlatform {
         message.formatHint = _videoFormatStringMap[dataSource.formatHint];
         message.httpHeaders = dataSource.httpHeaders;
         message.drmConfigs = dataSource.drmConfigs?.toMap();
-        message.playerOptions = dataSource.playerOptions;
+        message.playerOptions = dataSource.bufferConfigs == null
+            ? dataSource.playerOptions
+            : <String, dynamic>{
+                ...?dataSource.playerOptions,
+                'bufferConfigs': dataSource.bufferConfigs!.toMap(),
+              };
         message.streamingProperty = dataSource.streamingProperty == null
             ? null
             : <String, String>{
@@ -101,6 +110,26 @@ class VideoPlayerTizen extends VideoPlayerPlatform {
         PositionMessage(playerId: playerId, position: position.inMilliseconds));
   }
 
+  @override
+  Future<Uint8List> getThumbnail(DataSource dataSource, Duration position,
+      {int? maxWidth, int? maxHeight}) async {
+    final Uint8List? thumbnail =
+        await _thumbnailChannel.invokeMethod<Uint8List>(
+      'getThumbnail',
+      <String, Object?>{
+        if (dataSource.sourceType == DataSourceType.asset) ...<String, Object?>{
+          'asset': dataSource.asset,
+          'package': dataSource.package,
+        } else
+          'uri': dataSource.uri,
+        'position': position.inMilliseconds,
+        'maxWidth': maxWidth,
+        'maxHeight': maxHeight,
+      },
+    );
+    return thumbnail!;
+  }
+
   @override
   Future<List<VideoTrack>> getVideoTracks(int playerId) async {
     final TrackMessage response = await _api.track(TrackTypeMessage(
@@ -223,6 +252,10 @@ class VideoPlayerTizen extends VideoPlayerPlatform {
                 Duration(milliseconds: durationVal?[1] as int)),
             size: Size((map['width'] as num?)?.toDouble() ?? 0.0,
                 (map['height'] as num?)?.toDouble() ?? 0.0),
+            bufferConfigs: map['bufferConfigs'] == null
+                ? null
+                : BufferConfigs.fromMap(
+                    map['bufferConfigs']! as Map<Object?, Object?>),
           );
         case 'completed':
           return VideoEvent(
@@ -244,6 +277,11 @@ class VideoPlayerTizen extends VideoPlayerPlatform {
             eventType: VideoEventType.subtitleUpdate,
             text: map['text']! as String,
           );
+        case 'telemetry':
+          return VideoEvent(
+            eventType: VideoEventType.telemetry,
+            telemetry: PlaybackTelemetry.fromMap(map.cast<Object?, Object?>()),
+          );
         default:
           return VideoEvent(eventType: VideoEventType.unknown);
       }
@@ -10,14 +10,18 @@ import 'package:flutter/foundation.dart';
 import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
 
+import 'src/buffer_configs.dart';
 import 'src/closed_caption_file.dart';
 import 'src/drm_configs.dart';
 import 'src/hole.dart';
+import 'src/playback_telemetry.dart';
 import 'src/tracks.dart';
 import 'video_player_platform_interface.dart';
 
+export 'src/buffer_configs.dart';
 export 'src/closed_caption_file.dart';
 export 'src/drm_configs.dart';
+export 'src/playback_telemetry.dart';
 export 'src/tracks.dart';
 
 VideoPlayerPlatform? _lastVideoPlayerPlatform;
@@ -52,6 +56,8 @@ class VideoPlayerValue {
     this.isBuffering = false,
     this.volume = 1.0,
     this.playbackSpeed = 1.0,
+    this.bufferConfigs,
+    this.telemetry,
     this.errorDescription,
   });
 
@@ -112,6 +118,17 @@ class VideoPlayerValue {
   /// The current playback tracks.
   final List<Track> tracks;
 
+  /// The buffering configurations in effect, as reported by the platform.
+  ///
+  /// This is null if the platform doesn't report them.
+  final BufferConfigs? bufferConfigs;
+
+  /// The latest summary of the playback quality of experience.
+  ///
+  /// This is null unless `telemetryInterval` is set in
+  /// [VideoPlayerController.playerOptions].
+  final PlaybackTelemetry? telemetry;
+
   /// A description of the error if present.
   ///
   /// If [hasError] is false this is `null`.
@@ -160,6 +177,8 @@ class VideoPlayerValue {
     bool? isBuffering,
     double? volume,
     double? playbackSpeed,
+    BufferConfigs? bufferConfigs,
+    PlaybackTelemetry? telemetry,
     String? errorDescription = _defaultErrorDescription,
   }) {
     return VideoPlayerValue(
@@ -176,6 +195,8 @@ class VideoPlayerValue {
       isBuffering: isBuffering ?? this.isBuffering,
       volume: volume ?? this.volume,
       playbackSpeed: playbackSpeed ?? this.playbackSpeed,
+      bufferConfigs: bufferConfigs ?? this.bufferConfigs,
+      telemetry: telemetry ?? this.telemetry,
       errorDescription: errorDescription != _defaultErrorDescription
           ? errorDescription
           : this.errorDescription,
@@ -198,6 +219,8 @@ class VideoPlayerValue {
         'isBuffering: $isBuffering, '
         'volume: $volume, '
         'playbackSpeed: $playbackSpeed, '
+        'bufferConfigs: $bufferConfigs, '
+        'telemetry: $telemetry, '
         'errorDescription: $errorDescription)';
   }
 }
@@ -227,6 +250,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
         formatHint = null,
         httpHeaders = const <String, String>{},
         drmConfigs = null,
+        bufferConfigs = null,
         playerOptions = const <String, dynamic>{},
         streamingProperty = null,
         super(VideoPlayerValue(
@@ -248,6 +272,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
     this.videoPlayerOptions,
     this.httpHeaders = const <String, String>{},
     this.drmConfigs,
+    this.bufferConfigs,
     this.playerOptions,
     this.streamingProperty,
   })  : dataSourceType = DataSourceType.network,
@@ -269,6 +294,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
         formatHint = null,
         httpHeaders = const <String, String>{},
         drmConfigs = null,
+        bufferConfigs = null,
         playerOptions = const <String, dynamic>{},
         streamingProperty = null,
         super(VideoPlayerValue(
@@ -290,6 +316,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
         formatHint = null,
         httpHeaders = const <String, String>{},
         drmConfigs = null,
+        bufferConfigs = null,
         playerOptions = const <String, dynamic>{},
         streamingProperty = null,
         super(VideoPlayerValue(
@@ -308,6 +335,10 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
   /// Only for [VideoPlayerController.network].
   final DrmConfigs? drmConfigs;
 
+  /// Buffering configurations for the player (optional).
+  /// Only for [VideoPlayerController.network].
+  final BufferConfigs? bufferConfigs;
+
   /// Player Options used for add additional parameters.
   /// Only for [VideoPlayerController.network].
   final Map<String, dynamic>? playerOptions;
@@ -384,6 +415,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
           formatHint: formatHint,
           httpHeaders: httpHeaders,
           drmConfigs: drmConfigs,
+          bufferConfigs: bufferConfigs,
           playerOptions: playerOptions,
           streamingProperty: streamingProperty,
         );
@@ -420,6 +452,7 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
             duration: event.duration,
             size: event.size,
             isInitialized: event.duration != null,
+            bufferConfigs: event.bufferConfigs,
             errorDescription: null,
           );
           initializingCompleter.complete(null);
@@ -452,6 +485,8 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
             text: event.text ?? '',
           );
           value = value.copyWith(caption: caption);
+        case VideoEventType.telemetry:
+          value = value.copyWith(telemetry: event.telemetry);
         case VideoEventType.unknown:
           break;
       }
@@ -663,6 +698,27 @@ class VideoPlayerController extends ValueNotifier<VideoPlayerValue> {
     _updatePosition(position);
   }
 
+  /// Gets a JPEG thumbnail of the video at [position], e.g. to preview the
+  /// seek target while the user drags a progress bar.
+  ///
+  /// The thumbnail is decoded from the keyframe nearest to [position] and
+  /// scaled down to fit in [maxWidth] x [maxHeight] if given. Thumbnails are
+  /// cached, so requesting the same position again is cheap.
+  Future<Uint8List> getThumbnail(Duration position,
+      {int? maxWidth, int? maxHeight}) {
+    return _videoPlayerPlatform.getThumbnail(
+      DataSource(
+        sourceType: dataSourceType,
+        asset: dataSourceType == DataSourceType.asset ? dataSource : null,
+        uri: dataSourceType == DataSourceType.asset ? null : dataSource,
+        package: package,
+      ),
+      position,
+      maxWidth: maxWidth,
+      maxHeight: maxHeight,
+    );
+  }
+
   /// The video tracks in the current video.
   Future<List<VideoTrack>?> get videoTracks async {
     if (!value.isInitialized || _isDisposed) {
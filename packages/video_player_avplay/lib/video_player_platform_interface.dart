@@ -7,7 +7,9 @@ import 'package:flutter/foundation.dart';
 import 'package:flutter/widgets.dart';
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
+import 'src/buffer_configs.dart';
 import 'src/drm_configs.dart';
+import 'src/playback_telemetry.dart';
 import 'src/tracks.dart';
 import 'src/video_player_tizen.dart';
 
@@ -97,6 +99,14 @@ abstract class VideoPlayerPlatform extends PlatformInterface {
     throw UnimplementedError('seekTo() has not been implemented.');
   }
 
+  /// Gets a JPEG thumbnail of [dataSource] at [position] for seek previews.
+  ///
+  /// The thumbnail is scaled down to fit in [maxWidth] x [maxHeight] if given.
+  Future<Uint8List> getThumbnail(DataSource dataSource, Duration position,
+      {int? maxWidth, int? maxHeight}) {
+    throw UnimplementedError('getThumbnail() has not been implemented.');
+  }
+
   /// Gets the video tracks as a list of [VideoTrack].
   Future<List<VideoTrack>> getVideoTracks(int playerId) {
     throw UnimplementedError('getVideoTracks() has not been implemented.');
@@ -185,6 +195,7 @@ class DataSource {
     this.package,
     this.httpHeaders = const <String, String>{},
     this.drmConfigs,
+    this.bufferConfigs,
     this.playerOptions,
     this.streamingProperty,
   });
@@ -220,6 +231,9 @@ class DataSource {
   /// Configurations for playing DRM content.
   DrmConfigs? drmConfigs;
 
+  /// Buffering configurations for the player.
+  BufferConfigs? bufferConfigs;
+
   /// Set additional optional player settings.
   Map<String, dynamic>? playerOptions;
 
@@ -336,6 +350,8 @@ class VideoEvent {
     this.size,
     this.buffered,
     this.text,
+    this.bufferConfigs,
+    this.telemetry,
   });
 
   /// The type of the event.
@@ -361,6 +377,16 @@ class VideoEvent {
   /// Only used if [eventType] is [VideoEventType.subtitleUpdate].
   final String? text;
 
+  /// The effective buffering configurations of the player.
+  ///
+  /// Only used if [eventType] is [VideoEventType.initialized].
+  final BufferConfigs? bufferConfigs;
+
+  /// Summary of the playback quality of experience.
+  ///
+  /// Only used if [eventType] is [VideoEventType.telemetry].
+  final PlaybackTelemetry? telemetry;
+
   @override
   bool operator ==(Object other) {
     return identical(this, other) ||
@@ -405,6 +431,9 @@ enum VideoEventType {
   /// Updated the video subtitle text.
   subtitleUpdate,
 
+  /// A periodic summary of the playback quality of experience.
+  telemetry,
+
   /// An unknown event has been received.
   unknown,
 }
@@ -0,0 +1,109 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "event_dispatcher.h"
+
+#include "log.h"
+#include "video_player.h"
+
+void EventDispatcher::AddPlayer(VideoPlayer *player) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (player_count_++ > 0) {
+    return;
+  }
+  pipe_ = ecore_pipe_add(
+      [](void *data, void *buffer, unsigned int nbyte) -> void {
+        auto *self = static_cast<EventDispatcher *>(data);
+        self->DispatchEvents();
+      },
+      this);
+  if (!pipe_) {
+    LOG_ERROR("[EventDispatcher] Fail to add pipe.");
+  }
+}
+
+void EventDispatcher::RemovePlayer(VideoPlayer *player) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Event &event : pending_events_) {
+    if (event.player == player) {
+      event.player = nullptr;
+    }
+  }
+  last_event_index_.erase(player);
+
+  if (player_count_ > 0 && --player_count_ == 0) {
+    if (pipe_) {
+      ecore_pipe_del(pipe_);
+      pipe_ = nullptr;
+    }
+    pending_events_.clear();
+  }
+}
+
+void EventDispatcher::PostEvent(VideoPlayer *player,
+                                flutter::EncodableValue &&event,
+                                bool coalescable) {
+  Event pending_event;
+  pending_event.player = player;
+  pending_event.value = std::move(event);
+  pending_event.coalescable = coalescable;
+  Enqueue(std::move(pending_event));
+}
+
+void EventDispatcher::PostError(VideoPlayer *player,
+                                const std::string &error_code,
+                                const std::string &error_message) {
+  Event pending_event;
+  pending_event.player = player;
+  pending_event.is_error = true;
+  pending_event.error_code = error_code;
+  pending_event.error_message = error_message;
+  Enqueue(std::move(pending_event));
+}
+
+void EventDispatcher::Enqueue(Event &&event) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!pipe_) {
+    return;
+  }
+
+  if (event.coalescable) {
+    auto iter = last_event_index_.find(event.player);
+    if (iter != last_event_index_.end()) {
+      Event &last_event = pending_events_[iter->second];
+      if (last_event.coalescable) {
+        // The pending value is superseded and hasn't been delivered yet.
+        last_event.value = std::move(event.value);
+        return;
+      }
+    }
+  }
+
+  bool should_wake_up = pending_events_.empty();
+  last_event_index_[event.player] = pending_events_.size();
+  pending_events_.push_back(std::move(event));
+  if (should_wake_up) {
+    ecore_pipe_write(pipe_, nullptr, 0);
+  }
+}
+
+void EventDispatcher::DispatchEvents() {
+  std::vector<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events.swap(pending_events_);
+    last_event_index_.clear();
+  }
+
+  for (Event &event : events) {
+    if (!event.player) {
+      continue;
+    }
+    if (event.is_error) {
+      event.player->SinkError(event.error_code, event.error_message);
+    } else {
+      event.player->SinkEvent(event.value);
+    }
+  }
+}
@@ -0,0 +1,67 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_EVENT_DISPATCHER_H_
+#define FLUTTER_PLUGIN_EVENT_DISPATCHER_H_
+
+#include <Ecore.h>
+#include <flutter/encodable_value.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class VideoPlayer;
+
+// Delivers the events of all players to the main loop. Events posted from any
+// thread are batched so that the main loop is woken up at most once per
+// iteration, no matter how many players are posting.
+class EventDispatcher {
+ public:
+  static EventDispatcher &GetInstance() {
+    static EventDispatcher instance;
+    return instance;
+  }
+
+  EventDispatcher(const EventDispatcher &) = delete;
+  EventDispatcher &operator=(const EventDispatcher &) = delete;
+
+  // Must be called on the main thread.
+  void AddPlayer(VideoPlayer *player);
+  // Must be called on the main thread. Drops any pending events of |player|.
+  void RemovePlayer(VideoPlayer *player);
+
+  // Posts an event. If |coalescable| is true and the last pending event of
+  // |player| is also coalescable, the pending event is replaced instead.
+  void PostEvent(VideoPlayer *player, flutter::EncodableValue &&event,
+                 bool coalescable = false);
+  void PostError(VideoPlayer *player, const std::string &error_code,
+                 const std::string &error_message);
+
+ private:
+  struct Event {
+    VideoPlayer *player = nullptr;
+    flutter::EncodableValue value;
+    bool is_error = false;
+    bool coalescable = false;
+    std::string error_code;
+    std::string error_message;
+  };
+
+  EventDispatcher() = default;
+  ~EventDispatcher() = default;
+
+  void Enqueue(Event &&event);
+  void DispatchEvents();
+
+  std::mutex mutex_;
+  std::vector<Event> pending_events_;
+  // The index of the last pending event of each player.
+  std::map<VideoPlayer *, size_t> last_event_index_;
+  Ecore_Pipe *pipe_ = nullptr;
+  size_t player_count_ = 0;
+};
+
+#endif  // FLUTTER_PLUGIN_EVENT_DISPATCHER_H_
@@ -191,6 +191,8 @@ int64_t MediaPlayer::Create(const std::string &uri,
     return -1;
   }
 
+  StartTelemetry(flutter_common::GetValue(create_message.player_options(),
+                                          "telemetryInterval", 0));
   return SetUpEventChannel();
 }
 
@@ -224,11 +226,15 @@ bool MediaPlayer::Play() {
     LOG_INFO("[MediaPlayer] Player already playing.");
     return false;
   }
+  telemetry_.OnPlayRequested();
   ret = player_start(player_);
   if (ret != PLAYER_ERROR_NONE) {
     LOG_ERROR("[MediaPlayer] player_start failed: %s.", get_error_message(ret));
     return false;
   }
+  // There is no callback for the first rendered frame, so the first frame time
+  // is not reported.
+  telemetry_.OnPlayStarted();
   return true;
 }
 
@@ -435,149 +441,145 @@ bool MediaPlayer::SetDisplay() {
 }
 
 flutter::EncodableList MediaPlayer::GetTrackInfo(std::string track_type) {
+  return GetCachedTrackInfo(track_type);
+}
+
+bool MediaPlayer::BuildTrackCatalog(TrackCatalog &catalog) {
   player_state_e state = PLAYER_STATE_NONE;
   int ret = player_get_state(player_, &state);
   if (ret != PLAYER_ERROR_NONE) {
     LOG_ERROR("[MediaPlayer] player_get_state failed: %s",
               get_error_message(ret));
-    return {};
+    return false;
   }
   if (state == PLAYER_STATE_NONE || state == PLAYER_STATE_IDLE) {
     LOG_ERROR("[MediaPlayer] Player not ready.");
-    return {};
+    return false;
   }
 
-  player_stream_type_e type = ConvertTrackType(track_type);
-  int track_count = 0;
-  ret = media_player_proxy_->player_get_track_count_v2(player_, type,
-                                                       &track_count);
-  if (ret != PLAYER_ERROR_NONE) {
-    LOG_ERROR("[MediaPlayer] player_get_track_count_v2 failed: %s",
-              get_error_message(ret));
-    return {};
-  }
-  if (track_count <= 0) {
-    return {};
-  }
-
-  flutter::EncodableList trackSelections = {};
-  flutter::EncodableMap trackSelection = {};
-  trackSelection.insert(
-      {flutter::EncodableValue("trackType"), flutter::EncodableValue(type)});
-  if (type == PLAYER_STREAM_TYPE_VIDEO) {
-    LOG_INFO("[MediaPlayer] video_count: %d", track_count);
-
-    for (int video_index = 0; video_index < track_count; video_index++) {
-      player_video_track_info_v2 *video_track_info = nullptr;
-
-      ret = media_player_proxy_->player_get_video_track_info_v2(
-          player_, video_index, &video_track_info);
-      if (ret != PLAYER_ERROR_NONE) {
-        LOG_ERROR("[MediaPlayer] player_get_video_track_info_v2 failed: %s",
-                  get_error_message(ret));
-        return {};
-      }
-      LOG_INFO(
-          "[MediaPlayer] video track info: width[%d], height[%d], "
-          "bitrate[%d]",
-          video_track_info->width, video_track_info->height,
-          video_track_info->bit_rate);
-
-      trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                      flutter::EncodableValue(video_index));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("width"),
-          flutter::EncodableValue(video_track_info->width));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("height"),
-          flutter::EncodableValue(video_track_info->height));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("bitrate"),
-          flutter::EncodableValue(video_track_info->bit_rate));
-
-      trackSelections.push_back(flutter::EncodableValue(trackSelection));
-    }
+  int video_count = 0, audio_count = 0, subtitle_count = 0;
+  if (media_player_proxy_->player_get_track_count_v2(
+          player_, PLAYER_STREAM_TYPE_VIDEO, &video_count) !=
+          PLAYER_ERROR_NONE ||
+      media_player_proxy_->player_get_track_count_v2(
+          player_, PLAYER_STREAM_TYPE_AUDIO, &audio_count) !=
+          PLAYER_ERROR_NONE ||
+      media_player_proxy_->player_get_track_count_v2(
+          player_, PLAYER_STREAM_TYPE_TEXT, &subtitle_count) !=
+          PLAYER_ERROR_NONE) {
+    LOG_ERROR("[MediaPlayer] player_get_track_count_v2 failed.");
+    return false;
+  }
 
-  } else if (type == PLAYER_STREAM_TYPE_AUDIO) {
-    LOG_INFO("[MediaPlayer] audio_count: %d", track_count);
-
-    for (int audio_index = 0; audio_index < track_count; audio_index++) {
-      player_audio_track_info_v2 *audio_track_info = nullptr;
-
-      ret = media_player_proxy_->player_get_audio_track_info_v2(
-          player_, audio_index, &audio_track_info);
-      if (ret != PLAYER_ERROR_NONE) {
-        LOG_ERROR("[MediaPlayer] player_get_audio_track_info_v2 failed: %s",
-                  get_error_message(ret));
-        return {};
-      }
-      LOG_INFO(
-          "[MediaPlayer] audio track info: language[%s], channel[%d], "
-          "sample_rate[%d], bitrate[%d]",
-          audio_track_info->language, audio_track_info->channel,
-          audio_track_info->sample_rate, audio_track_info->bit_rate);
-
-      trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                      flutter::EncodableValue(audio_index));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("language"),
-          flutter::EncodableValue(std::string(audio_track_info->language)));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("channel"),
-          flutter::EncodableValue(audio_track_info->channel));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("bitrate"),
-          flutter::EncodableValue(audio_track_info->bit_rate));
-
-      trackSelections.push_back(flutter::EncodableValue(trackSelection));
-    }
+  flutter::EncodableList video_tracks;
+  LOG_INFO("[MediaPlayer] video_count: %d", video_count);
+  for (int video_index = 0; video_index < video_count; video_index++) {
+    player_video_track_info_v2 *video_track_info = nullptr;
 
-  } else if (type == PLAYER_STREAM_TYPE_TEXT) {
-    LOG_INFO("[MediaPlayer] subtitle_count: %d", track_count);
-
-    for (int sub_index = 0; sub_index < track_count; sub_index++) {
-      player_subtitle_track_info_v2 *sub_track_info = nullptr;
-
-      ret = media_player_proxy_->player_get_subtitle_track_info_v2(
-          player_, sub_index, &sub_track_info);
-      if (ret != PLAYER_ERROR_NONE) {
-        LOG_ERROR("[MediaPlayer] player_get_subtitle_track_info_v2 failed: %s",
-                  get_error_message(ret));
-        return {};
-      }
-      LOG_INFO("[MediaPlayer] subtitle track info: language[%s]",
-               sub_track_info->language);
-
-      trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                      flutter::EncodableValue(sub_index));
-      trackSelection.insert_or_assign(
-          flutter::EncodableValue("language"),
-          flutter::EncodableValue(std::string(sub_track_info->language)));
-
-      trackSelections.push_back(flutter::EncodableValue(trackSelection));
+    ret = media_player_proxy_->player_get_video_track_info_v2(
+        player_, video_index, &video_track_info);
+    if (ret != PLAYER_ERROR_NONE) {
+      LOG_ERROR("[MediaPlayer] player_get_video_track_info_v2 failed: %s",
+                get_error_message(ret));
+      return false;
     }
-  }
-
-  return trackSelections;
+    LOG_INFO(
+        "[MediaPlayer] video track info: width[%d], height[%d], "
+        "bitrate[%d]",
+        video_track_info->width, video_track_info->height,
+        video_track_info->bit_rate);
+
+    flutter::EncodableMap track_selection = {
+        {flutter::EncodableValue("trackType"),
+         flutter::EncodableValue(PLAYER_STREAM_TYPE_VIDEO)},
+        {flutter::EncodableValue("trackId"),
+         flutter::EncodableValue(video_index)},
+        {flutter::EncodableValue("width"),
+         flutter::EncodableValue(video_track_info->width)},
+        {flutter::EncodableValue("height"),
+         flutter::EncodableValue(video_track_info->height)},
+        {flutter::EncodableValue("bitrate"),
+         flutter::EncodableValue(video_track_info->bit_rate)},
+    };
+    video_tracks.push_back(flutter::EncodableValue(track_selection));
+  }
+
+  flutter::EncodableList audio_tracks;
+  LOG_INFO("[MediaPlayer] audio_count: %d", audio_count);
+  for (int audio_index = 0; audio_index < audio_count; audio_index++) {
+    player_audio_track_info_v2 *audio_track_info = nullptr;
+
+    ret = media_player_proxy_->player_get_audio_track_info_v2(
+        player_, audio_index, &audio_track_info);
+    if (ret != PLAYER_ERROR_NONE) {
+      LOG_ERROR("[MediaPlayer] player_get_audio_track_info_v2 failed: %s",
+                get_error_message(ret));
+      return false;
+    }
+    LOG_INFO(
+        "[MediaPlayer] audio track info: language[%s], channel[%d], "
+        "sample_rate[%d], bitrate[%d]",
+        audio_track_info->language, audio_track_info->channel,
+        audio_track_info->sample_rate, audio_track_info->bit_rate);
+
+    flutter::EncodableMap track_selection = {
+        {flutter::EncodableValue("trackType"),
+         flutter::EncodableValue(PLAYER_STREAM_TYPE_AUDIO)},
+        {flutter::EncodableValue("trackId"),
+         flutter::EncodableValue(audio_index)},
+        {flutter::EncodableValue("language"),
+         flutter::EncodableValue(std::string(audio_track_info->language))},
+        {flutter::EncodableValue("channel"),
+         flutter::EncodableValue(audio_track_info->channel)},
+        {flutter::EncodableValue("bitrate"),
+         flutter::EncodableValue(audio_track_info->bit_rate)},
+    };
+    audio_tracks.push_back(flutter::EncodableValue(track_selection));
+  }
+
+  flutter::EncodableList subtitle_tracks;
+  LOG_INFO("[MediaPlayer] subtitle_count: %d", subtitle_count);
+  for (int sub_index = 0; sub_index < subtitle_count; sub_index++) {
+    player_subtitle_track_info_v2 *sub_track_info = nullptr;
+
+    ret = media_player_proxy_->player_get_subtitle_track_info_v2(
+        player_, sub_index, &sub_track_info);
+    if (ret != PLAYER_ERROR_NONE) {
+      LOG_ERROR("[MediaPlayer] player_get_subtitle_track_info_v2 failed: %s",
+                get_error_message(ret));
+      return false;
+    }
+    LOG_INFO("[MediaPlayer] subtitle track info: language[%s]",
+             sub_track_info->language);
+
+    flutter::EncodableMap track_selection = {
+        {flutter::EncodableValue("trackType"),
+         flutter::EncodableValue(PLAYER_STREAM_TYPE_TEXT)},
+        {flutter::EncodableValue("trackId"),
+         flutter::EncodableValue(sub_index)},
+        {flutter::EncodableValue("language"),
+         flutter::EncodableValue(std::string(sub_track_info->language))},
+    };
+    subtitle_tracks.push_back(flutter::EncodableValue(track_selection));
+  }
+
+  catalog["video"] = std::move(video_tracks);
+  catalog["audio"] = std::move(audio_tracks);
+  catalog["text"] = std::move(subtitle_tracks);
+  return true;
 }
 
 bool MediaPlayer::SetTrackSelection(int32_t track_id, std::string track_type) {
   LOG_INFO("[MediaPlayer] track_id: %d,track_type: %s", track_id,
            track_type.c_str());
 
-  player_state_e state = PLAYER_STATE_NONE;
-  int ret = player_get_state(player_, &state);
-  if (ret != PLAYER_ERROR_NONE) {
-    LOG_ERROR("[MediaPlayer] player_get_state failed: %s",
-              get_error_message(ret));
-    return false;
-  }
-  if (state == PLAYER_STATE_NONE || state == PLAYER_STATE_IDLE) {
-    LOG_ERROR("[MediaPlayer] Player not ready.");
+  if (!HasCachedTrack(track_id, track_type)) {
+    LOG_ERROR("[MediaPlayer] Track not found.");
     return false;
   }
 
-  ret = player_select_track(player_, ConvertTrackType(track_type), track_id);
+  int ret =
+      player_select_track(player_, ConvertTrackType(track_type), track_id);
   if (ret != PLAYER_ERROR_NONE) {
     LOG_ERROR("[MediaPlayer] player_select_track failed: %s",
               get_error_message(ret));
@@ -589,6 +591,7 @@ bool MediaPlayer::SetTrackSelection(int32_t track_id, std::string track_type) {
 
 bool MediaPlayer::SetDrm(const std::string &uri, int drm_type,
                          const std::string &license_server_url) {
+  telemetry_.OnDrmStarted();
   drm_manager_ = std::make_unique<DrmManager>();
   if (!drm_manager_->CreateDrmSession(drm_type, false)) {
     LOG_ERROR("[MediaPlayer] Failed to create drm session.");
@@ -644,6 +647,8 @@ void MediaPlayer::OnPrepared(void *user_data) {
   LOG_INFO("[MediaPlayer] Player prepared.");
 
   MediaPlayer *self = static_cast<MediaPlayer *>(user_data);
+  self->telemetry_.OnPrepared();
+  self->RefreshTrackCatalog();
   if (!self->is_initialized_) {
     self->SendInitialized();
   }
@@ -712,8 +717,12 @@ bool MediaPlayer::OnDrmSecurityInitComplete(int *drm_handle,
 
   MediaPlayer *self = static_cast<MediaPlayer *>(user_data);
   if (self->drm_manager_) {
-    return self->drm_manager_->SecurityInitCompleteCB(drm_handle, length,
-                                                      pssh_data, self->player_);
+    bool ret = self->drm_manager_->SecurityInitCompleteCB(
+        drm_handle, length, pssh_data, self->player_);
+    if (ret) {
+      self->telemetry_.OnDrmCompleted();
+    }
+    return ret;
   }
   return false;
 }
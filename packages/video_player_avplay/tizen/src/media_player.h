@@ -46,6 +46,7 @@ class MediaPlayer : public VideoPlayer {
   bool SetDisplay();
   bool SetDrm(const std::string &uri, int drm_type,
               const std::string &license_server_url);
+  bool BuildTrackCatalog(TrackCatalog &catalog) override;
 
   static void OnPrepared(void *user_data);
   static void OnBuffering(int percent, void *user_data);
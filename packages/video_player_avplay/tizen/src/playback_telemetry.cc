@@ -0,0 +1,141 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "playback_telemetry.h"
+
+// The maximum number of buffer level samples kept between two summaries.
+static constexpr size_t kMaxBufferLevelSamples = 64;
+
+PlaybackTelemetry::PlaybackTelemetry() : created_time_(Clock::now()) {}
+
+int64_t PlaybackTelemetry::ToMilliseconds(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+      .count();
+}
+
+void PlaybackTelemetry::OnDrmStarted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  drm_start_time_ = Clock::now();
+}
+
+void PlaybackTelemetry::OnDrmCompleted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Only the first license acquisition contributes to the startup time.
+  if (drm_time_ < 0) {
+    drm_time_ = ToMilliseconds(Clock::now() - drm_start_time_);
+  }
+}
+
+void PlaybackTelemetry::OnPrepared() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (prepare_time_ < 0) {
+    prepare_time_ = ToMilliseconds(Clock::now() - created_time_);
+  }
+}
+
+void PlaybackTelemetry::OnPlayRequested() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_play_started_) {
+    play_requested_time_ = Clock::now();
+  }
+}
+
+void PlaybackTelemetry::OnFirstFrame() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_play_started_) {
+    first_frame_time_ = ToMilliseconds(Clock::now() - play_requested_time_);
+    is_play_started_ = true;
+  }
+}
+
+void PlaybackTelemetry::OnPlayStarted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_play_started_ = true;
+}
+
+void PlaybackTelemetry::OnBitrateChanged(int64_t bitrate) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bitrate == bitrate_) {
+    return;
+  }
+  if (bitrate_ != 0) {
+    bitrate_switch_count_++;
+  }
+  bitrate_ = bitrate;
+}
+
+void PlaybackTelemetry::OnBufferLevel(int32_t percent) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer_level_ = percent;
+  if (buffer_levels_.size() == kMaxBufferLevelSamples) {
+    buffer_levels_.pop_front();
+  }
+  buffer_levels_.emplace_back(ToMilliseconds(Clock::now() - created_time_),
+                              percent);
+}
+
+void PlaybackTelemetry::OnBufferingStart() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Buffering before the playback starts is part of the startup time.
+  if (!is_play_started_ || is_rebuffering_) {
+    return;
+  }
+  is_rebuffering_ = true;
+  rebuffer_start_time_ = Clock::now();
+  rebuffer_count_++;
+}
+
+void PlaybackTelemetry::OnBufferingEnd() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_rebuffering_) {
+    return;
+  }
+  is_rebuffering_ = false;
+  rebuffer_duration_ += Clock::now() - rebuffer_start_time_;
+}
+
+flutter::EncodableMap PlaybackTelemetry::TakeSummary() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  flutter::EncodableMap startup;
+  if (prepare_time_ >= 0) {
+    startup[flutter::EncodableValue("prepare")] =
+        flutter::EncodableValue(prepare_time_);
+  }
+  if (drm_time_ >= 0) {
+    startup[flutter::EncodableValue("drm")] =
+        flutter::EncodableValue(drm_time_);
+  }
+  if (first_frame_time_ >= 0) {
+    startup[flutter::EncodableValue("firstFrame")] =
+        flutter::EncodableValue(first_frame_time_);
+  }
+
+  flutter::EncodableList buffer_levels;
+  for (const auto &[time, percent] : buffer_levels_) {
+    buffer_levels.push_back(flutter::EncodableValue(flutter::EncodableList{
+        flutter::EncodableValue(time), flutter::EncodableValue(percent)}));
+  }
+  buffer_levels_.clear();
+
+  Clock::duration rebuffer_duration = rebuffer_duration_;
+  if (is_rebuffering_) {
+    rebuffer_duration += Clock::now() - rebuffer_start_time_;
+  }
+
+  return {
+      {flutter::EncodableValue("startup"), flutter::EncodableValue(startup)},
+      {flutter::EncodableValue("bitrate"), flutter::EncodableValue(bitrate_)},
+      {flutter::EncodableValue("bitrateSwitches"),
+       flutter::EncodableValue(bitrate_switch_count_)},
+      {flutter::EncodableValue("bufferLevel"),
+       flutter::EncodableValue(buffer_level_)},
+      {flutter::EncodableValue("bufferLevels"),
+       flutter::EncodableValue(buffer_levels)},
+      {flutter::EncodableValue("rebufferCount"),
+       flutter::EncodableValue(rebuffer_count_)},
+      {flutter::EncodableValue("rebufferDuration"),
+       flutter::EncodableValue(ToMilliseconds(rebuffer_duration))},
+  };
+}
@@ -0,0 +1,70 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_PLAYBACK_TELEMETRY_H_
+#define FLUTTER_PLUGIN_PLAYBACK_TELEMETRY_H_
+
+#include <flutter/encodable_value.h>
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// Aggregates playback quality of experience data reported by the player
+// callbacks. The callbacks may be invoked from any thread.
+class PlaybackTelemetry {
+ public:
+  PlaybackTelemetry();
+  ~PlaybackTelemetry() = default;
+
+  PlaybackTelemetry(const PlaybackTelemetry &) = delete;
+  PlaybackTelemetry &operator=(const PlaybackTelemetry &) = delete;
+
+  void OnDrmStarted();
+  void OnDrmCompleted();
+  void OnPrepared();
+  void OnPlayRequested();
+  void OnFirstFrame();
+  // Marks the playback as started without recording a first frame time, for
+  // players that can't report when the first frame is rendered.
+  void OnPlayStarted();
+  void OnBitrateChanged(int64_t bitrate);
+  void OnBufferLevel(int32_t percent);
+  void OnBufferingStart();
+  void OnBufferingEnd();
+
+  // Returns the summary of the playback so far. The buffer level samples are
+  // cleared so that each summary only carries the samples since the last one.
+  flutter::EncodableMap TakeSummary();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static int64_t ToMilliseconds(Clock::duration duration);
+
+  std::mutex mutex_;
+
+  Clock::time_point created_time_;
+  Clock::time_point drm_start_time_;
+  Clock::time_point play_requested_time_;
+  int64_t prepare_time_ = -1;
+  int64_t drm_time_ = -1;
+  int64_t first_frame_time_ = -1;
+  bool is_play_started_ = false;
+
+  int64_t bitrate_ = 0;
+  int64_t bitrate_switch_count_ = 0;
+
+  // Pairs of the elapsed time since creation and the buffer level.
+  std::deque<std::pair<int64_t, int32_t>> buffer_levels_;
+  int32_t buffer_level_ = 0;
+
+  bool is_rebuffering_ = false;
+  Clock::time_point rebuffer_start_time_;
+  int64_t rebuffer_count_ = 0;
+  Clock::duration rebuffer_duration_ = Clock::duration::zero();
+};
+
+#endif  // FLUTTER_PLUGIN_PLAYBACK_TELEMETRY_H_
@@ -7,10 +7,36 @@
 #include <app_manager.h>
 #include <system_info.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 
 #include "log.h"
 
+enum class BufferConfigUnit { kByte, kMillisecond, kSecond };
+
+struct BufferConfigEntry {
+  // The option name used by the Dart side. Durations are in milliseconds.
+  const char *option_name;
+  // The buffer config name used by plusplayer.
+  const char *config_name;
+  BufferConfigUnit unit;
+};
+
+static const BufferConfigEntry kBufferConfigEntries[] = {
+    {"maxBufferSize", "total_buffer_size_in_byte", BufferConfigUnit::kByte},
+    {"maxBufferDuration", "total_buffer_size_in_time",
+     BufferConfigUnit::kMillisecond},
+    {"initialBufferDuration", "buffer_size_in_sec_for_play",
+     BufferConfigUnit::kSecond},
+    {"rebufferDuration", "buffer_size_in_sec_for_resume",
+     BufferConfigUnit::kSecond},
+    {"bufferingTimeout", "buffering_timeout_in_sec_for_play",
+     BufferConfigUnit::kSecond},
+};
+
 static std::vector<std::string> split(const std::string &s, char delim) {
   std::stringstream ss(s);
   std::string item;
@@ -21,6 +47,16 @@ static std::vector<std::string> split(const std::string &s, char delim) {
   return tokens;
 }
 
+// The message of kBitrateChange carries the new bitrate either as a plain
+// number or in the form of "BITRATE=<number>".
+static int64_t ParseBitrate(const std::string &message) {
+  size_t pos = message.find_first_of("0123456789");
+  if (pos == std::string::npos) {
+    return 0;
+  }
+  return std::strtoll(message.c_str() + pos, nullptr, 10);
+}
+
 static plusplayer::TrackType ConvertTrackType(std::string track_type) {
   if (track_type == "video") {
     return plusplayer::TrackType::kTrackTypeVideo;
@@ -34,6 +70,48 @@ static plusplayer::TrackType ConvertTrackType(std::string track_type) {
   return plusplayer::TrackType::kTrackTypeMax;
 }
 
+static flutter::EncodableMap GetBufferConfigPreset(const std::string &preset) {
+  if (preset == "lowLatency") {
+    return {
+        {flutter::EncodableValue("maxBufferDuration"),
+         flutter::EncodableValue(4000)},
+        {flutter::EncodableValue("initialBufferDuration"),
+         flutter::EncodableValue(1000)},
+        {flutter::EncodableValue("rebufferDuration"),
+         flutter::EncodableValue(1000)},
+        {flutter::EncodableValue("bufferingTimeout"),
+         flutter::EncodableValue(5000)},
+    };
+  }
+  if (preset == "balanced") {
+    return {
+        {flutter::EncodableValue("maxBufferDuration"),
+         flutter::EncodableValue(15000)},
+        {flutter::EncodableValue("initialBufferDuration"),
+         flutter::EncodableValue(2000)},
+        {flutter::EncodableValue("rebufferDuration"),
+         flutter::EncodableValue(3000)},
+        {flutter::EncodableValue("bufferingTimeout"),
+         flutter::EncodableValue(10000)},
+    };
+  }
+  if (preset == "resilient") {
+    return {
+        {flutter::EncodableValue("maxBufferSize"),
+         flutter::EncodableValue(64 * 1024 * 1024)},
+        {flutter::EncodableValue("maxBufferDuration"),
+         flutter::EncodableValue(60000)},
+        {flutter::EncodableValue("initialBufferDuration"),
+         flutter::EncodableValue(5000)},
+        {flutter::EncodableValue("rebufferDuration"),
+         flutter::EncodableValue(10000)},
+        {flutter::EncodableValue("bufferingTimeout"),
+         flutter::EncodableValue(30000)},
+    };
+  }
+  return {};
+}
+
 PlusPlayer::PlusPlayer(flutter::BinaryMessenger *messenger,
                        FlutterDesktopViewRef flutter_view)
     : VideoPlayer(messenger, flutter_view) {}
@@ -63,6 +141,7 @@ void PlusPlayer::RegisterListener() {
   listener_.prepared_callback = OnPrepareDone;
   listener_.seek_completed_callback = OnSeekDone;
   listener_.subtitle_data_callback = OnSubtitleData;
+  listener_.state_changed_to_playing_callback = OnStateChangedToPlaying;
   ::RegisterListener(player_, &listener_, this);
 }
 
@@ -137,10 +216,20 @@ int64_t PlusPlayer::Create(const std::string &uri,
     is_prebuffer_mode_ = true;
   }
 
+  flutter::EncodableMap buffer_configs = flutter_common::GetValue(
+      create_message.player_options(), "bufferConfigs",
+      flutter::EncodableMap());
+  if (!buffer_configs.empty()) {
+    SetBufferConfigs(buffer_configs);
+  }
+
   if (!PrepareAsync(player_)) {
     LOG_ERROR("[PlusPlayer] Player fail to prepare.");
     return -1;
   }
+
+  StartTelemetry(flutter_common::GetValue(create_message.player_options(),
+                                          "telemetryInterval", 0));
   return SetUpEventChannel();
 }
 
@@ -171,6 +260,7 @@ bool PlusPlayer::Play() {
   }
 
   if (state <= plusplayer::State::kReady) {
+    telemetry_.OnPlayRequested();
     if (!Start(player_)) {
       LOG_ERROR("[PlusPlayer] Player fail to start.");
       return false;
@@ -409,90 +499,69 @@ flutter::EncodableList PlusPlayer::GetTrackInfo(std::string track_type) {
     LOG_ERROR("[PlusPlayer] Player not created.");
     return {};
   }
+  return GetCachedTrackInfo(track_type);
+}
 
+bool PlusPlayer::BuildTrackCatalog(TrackCatalog &catalog) {
   plusplayer::State state = GetState(player_);
   if (state < plusplayer::State::kTrackSourceReady) {
     LOG_ERROR("[PlusPlayer] Player is in invalid state.");
-    return {};
-  }
-
-  plusplayer::TrackType type = ConvertTrackType(track_type);
-
-  int track_count = GetTrackCount(player_, type);
-  if (track_count <= 0) {
-    return {};
+    return false;
   }
 
   const std::vector<plusplayer::Track> track_info = ::GetTrackInfo(player_);
-  if (track_info.empty()) {
-    return {};
-  }
 
-  flutter::EncodableList trackSelections = {};
-  flutter::EncodableMap trackSelection = {};
-  trackSelection.insert(
-      {flutter::EncodableValue("trackType"), flutter::EncodableValue(type)});
-  if (type == plusplayer::TrackType::kTrackTypeVideo) {
-    LOG_INFO("[PlusPlayer] Video track count: %d", track_count);
-    for (const auto &track : track_info) {
-      if (track.type == plusplayer::kTrackTypeVideo) {
-        trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                        flutter::EncodableValue(track.index));
-        trackSelection.insert_or_assign(flutter::EncodableValue("width"),
-                                        flutter::EncodableValue(track.width));
-        trackSelection.insert_or_assign(flutter::EncodableValue("height"),
-                                        flutter::EncodableValue(track.height));
-        trackSelection.insert_or_assign(flutter::EncodableValue("bitrate"),
-                                        flutter::EncodableValue(track.bitrate));
-        LOG_INFO(
-            "[PlusPlayer] video track info[%d]: width[%d], height[%d], "
-            "bitrate[%d]",
-            track.index, track.width, track.height, track.bitrate);
-
-        trackSelections.push_back(flutter::EncodableValue(trackSelection));
-      }
-    }
-  } else if (type == plusplayer::TrackType::kTrackTypeAudio) {
-    LOG_INFO("[PlusPlayer] Audio track count: %d", track_count);
-    for (const auto &track : track_info) {
-      if (track.type == plusplayer::kTrackTypeAudio) {
-        trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                        flutter::EncodableValue(track.index));
-        trackSelection.insert_or_assign(
-            flutter::EncodableValue("language"),
-            flutter::EncodableValue(track.language_code));
-        trackSelection.insert_or_assign(
-            flutter::EncodableValue("channel"),
-            flutter::EncodableValue(track.channels));
-        trackSelection.insert_or_assign(flutter::EncodableValue("bitrate"),
-                                        flutter::EncodableValue(track.bitrate));
-        LOG_INFO(
-            "[PlusPlayer] Audio track info[%d]: language[%s], channel[%d], "
-            "sample_rate[%d], bitrate[%d]",
-            track.index, track.language_code.c_str(), track.channels,
-            track.sample_rate, track.bitrate);
-
-        trackSelections.push_back(flutter::EncodableValue(trackSelection));
-      }
-    }
-  } else if (type == plusplayer::TrackType::kTrackTypeSubtitle) {
-    LOG_INFO("[PlusPlayer] Subtitle track count: %d", track_count);
-    for (const auto &track : track_info) {
-      if (track.type == plusplayer::kTrackTypeSubtitle) {
-        trackSelection.insert_or_assign(flutter::EncodableValue("trackId"),
-                                        flutter::EncodableValue(track.index));
-        trackSelection.insert_or_assign(
-            flutter::EncodableValue("language"),
-            flutter::EncodableValue(track.language_code));
-        LOG_INFO("[PlusPlayer] Subtitle track info[%d]: language[%s]",
-                 track.index, track.language_code.c_str());
-
-        trackSelections.push_back(flutter::EncodableValue(trackSelection));
-      }
+  flutter::EncodableList video_tracks, audio_tracks, subtitle_tracks;
+  for (const auto &track : track_info) {
+    flutter::EncodableMap track_selection = {
+        {flutter::EncodableValue("trackType"),
+         flutter::EncodableValue(track.type)},
+        {flutter::EncodableValue("trackId"),
+         flutter::EncodableValue(track.index)},
+    };
+    if (track.type == plusplayer::kTrackTypeVideo) {
+      track_selection[flutter::EncodableValue("width")] =
+          flutter::EncodableValue(track.width);
+      track_selection[flutter::EncodableValue("height")] =
+          flutter::EncodableValue(track.height);
+      track_selection[flutter::EncodableValue("bitrate")] =
+          flutter::EncodableValue(track.bitrate);
+      LOG_INFO(
+          "[PlusPlayer] video track info[%d]: width[%d], height[%d], "
+          "bitrate[%d]",
+          track.index, track.width, track.height, track.bitrate);
+
+      video_tracks.push_back(flutter::EncodableValue(track_selection));
+    } else if (track.type == plusplayer::kTrackTypeAudio) {
+      track_selection[flutter::EncodableValue("language")] =
+          flutter::EncodableValue(track.language_code);
+      track_selection[flutter::EncodableValue("channel")] =
+          flutter::EncodableValue(track.channels);
+      track_selection[flutter::EncodableValue("bitrate")] =
+          flutter::EncodableValue(track.bitrate);
+      LOG_INFO(
+          "[PlusPlayer] Audio track info[%d]: language[%s], channel[%d], "
+          "sample_rate[%d], bitrate[%d]",
+          track.index, track.language_code.c_str(), track.channels,
+          track.sample_rate, track.bitrate);
+
+      audio_tracks.push_back(flutter::EncodableValue(track_selection));
+    } else if (track.type == plusplayer::kTrackTypeSubtitle) {
+      track_selection[flutter::EncodableValue("language")] =
+          flutter::EncodableValue(track.language_code);
+      LOG_INFO("[PlusPlayer] Subtitle track info[%d]: language[%s]",
+               track.index, track.language_code.c_str());
+
+      subtitle_tracks.push_back(flutter::EncodableValue(track_selection));
     }
   }
+  LOG_INFO("[PlusPlayer] Track count: video[%zu], audio[%zu], subtitle[%zu]",
+           video_tracks.size(), audio_tracks.size(), subtitle_tracks.size());
 
-  return trackSelections;
+  catalog["video"] = std::move(video_tracks);
+  catalog["audio"] = std::move(audio_tracks);
+  catalog["text"] = std::move(subtitle_tracks);
+  return true;
 }
 
 bool PlusPlayer::SetTrackSelection(int32_t track_id, std::string track_type) {
@@ -504,9 +573,8 @@ bool PlusPlayer::SetTrackSelection(int32_t track_id, std::string track_type) {
     return false;
   }
 
-  plusplayer::State state = GetState(player_);
-  if (state < plusplayer::State::kTrackSourceReady) {
-    LOG_ERROR("[PlusPlayer] Player is in invalid state.");
+  if (!HasCachedTrack(track_id, track_type)) {
+    LOG_ERROR("[PlusPlayer] Track not found.");
     return false;
   }
 
@@ -519,6 +587,7 @@ bool PlusPlayer::SetTrackSelection(int32_t track_id, std::string track_type) {
 
 bool PlusPlayer::SetDrm(const std::string &uri, int drm_type,
                         const std::string &license_server_url) {
+  telemetry_.OnDrmStarted();
   drm_manager_ = std::make_unique<DrmManager>();
   if (!drm_manager_->CreateDrmSession(drm_type, true)) {
     LOG_ERROR("[PlusPlayer] Fail to create drm session.");
@@ -569,6 +638,70 @@ bool PlusPlayer::SetDrm(const std::string &uri, int drm_type,
   return true;
 }
 
+void PlusPlayer::SetBufferConfigs(const flutter::EncodableMap &buffer_configs) {
+  std::string preset =
+      flutter_common::GetValue(&buffer_configs, "preset", std::string());
+  flutter::EncodableMap options = GetBufferConfigPreset(preset);
+  if (!preset.empty() && options.empty()) {
+    LOG_ERROR("[PlusPlayer] Unknown buffering preset: %s.", preset.c_str());
+  }
+  // Explicitly set values take precedence over the preset.
+  for (const auto &[key, value] : buffer_configs) {
+    if (!value.IsNull()) {
+      options[key] = value;
+    }
+  }
+
+  for (const BufferConfigEntry &entry : kBufferConfigEntries) {
+    auto iter = options.find(flutter::EncodableValue(entry.option_name));
+    if (iter == options.end() ||
+        !(std::holds_alternative<int32_t>(iter->second) ||
+          std::holds_alternative<int64_t>(iter->second))) {
+      continue;
+    }
+    int64_t value = iter->second.LongValue();
+    if (value < 0) {
+      LOG_ERROR("[PlusPlayer] Invalid buffer config %s: %lld.",
+                entry.option_name, value);
+      continue;
+    }
+    if (entry.unit == BufferConfigUnit::kSecond) {
+      value = static_cast<int64_t>(std::ceil(value / 1000.0));
+    }
+    value = std::min<int64_t>(value, std::numeric_limits<int>::max());
+
+    LOG_INFO("[PlusPlayer] Buffer config %s: %lld.", entry.config_name, value);
+    if (!SetBufferConfig(player_, std::make_pair(std::string(entry.config_name),
+                                                 static_cast<int>(value)))) {
+      LOG_ERROR("[PlusPlayer] Fail to set buffer config %s.",
+                entry.config_name);
+    }
+  }
+}
+
+flutter::EncodableMap PlusPlayer::GetBufferConfigs() {
+  plusplayer::PlayerMemento memento;
+  if (!GetMemento(player_, &memento)) {
+    LOG_ERROR("[PlusPlayer] Player fail to get memento.");
+    return {};
+  }
+
+  flutter::EncodableMap buffer_configs;
+  for (const BufferConfigEntry &entry : kBufferConfigEntries) {
+    auto iter = memento.buffer_config.find(entry.config_name);
+    if (iter == memento.buffer_config.end()) {
+      continue;
+    }
+    int64_t value = iter->second;
+    if (entry.unit == BufferConfigUnit::kSecond) {
+      value *= 1000;
+    }
+    buffer_configs[flutter::EncodableValue(entry.option_name)] =
+        flutter::EncodableValue(value);
+  }
+  return buffer_configs;
+}
+
 std::string PlusPlayer::GetStreamingProperty(
     const std::string &streaming_property_type) {
   if (!player_) {
@@ -589,8 +722,12 @@ bool PlusPlayer::OnLicenseAcquired(int *drm_handle, unsigned int length,
   PlusPlayer *self = static_cast<PlusPlayer *>(user_data);
 
   if (self->drm_manager_) {
-    return self->drm_manager_->SecurityInitCompleteCB(drm_handle, length,
-                                                      pssh_data, nullptr);
+    bool ret = self->drm_manager_->SecurityInitCompleteCB(drm_handle, length,
+                                                          pssh_data, nullptr);
+    if (ret) {
+      self->telemetry_.OnDrmCompleted();
+    }
+    return ret;
   }
   return false;
 }
@@ -603,6 +740,10 @@ void PlusPlayer::OnPrepareDone(bool ret, void *user_data) {
     LOG_ERROR("[PlusPlayer] Fail to set display visible.");
   }
 
+  if (ret) {
+    self->telemetry_.OnPrepared();
+    self->RefreshTrackCatalog();
+  }
   if (!self->is_initialized_ && ret) {
     self->SendInitialized();
   }
@@ -682,6 +823,7 @@ void PlusPlayer::OnDrmInitData(int *drm_handle, unsigned int len,
   if (self->drm_manager_) {
     if (self->drm_manager_->SecurityInitCompleteCB(drm_handle, len, pssh_data,
                                                    nullptr)) {
+      self->telemetry_.OnDrmCompleted();
       DrmLicenseAcquiredDone(self->player_, type);
     }
   }
@@ -703,6 +845,16 @@ void PlusPlayer::OnAdaptiveStreamingControlEvent(
     if (self->drm_manager_) {
       self->drm_manager_->UpdatePsshData(msg.data.data(), msg.size);
     }
+  } else if (type == plusplayer::StreamingMessageType::kStreamMrsUrlChanged ||
+             type == plusplayer::StreamingMessageType::kSparseTrackDetect) {
+    // The set of tracks may have changed, query it again on the next request.
+    self->InvalidateTrackCatalog();
+  } else if (type == plusplayer::StreamingMessageType::kBitrateChange) {
+    int64_t bitrate = ParseBitrate(msg.data);
+    LOG_INFO("[PlusPlayer] Bitrate changed: %lld.", bitrate);
+    if (bitrate > 0) {
+      self->telemetry_.OnBitrateChanged(bitrate);
+    }
   }
 }
 
@@ -721,4 +873,9 @@ void PlusPlayer::OnCueOutContEvent(const char *cue_out_cont_data,
 
 void PlusPlayer::OnChangeSourceDone(bool ret, void *user_data) {}
 
-void PlusPlayer::OnStateChangedToPlaying(void *user_data) {}
+void PlusPlayer::OnStateChangedToPlaying(void *user_data) {
+  LOG_INFO("[PlusPlayer] State changed to playing.");
+  PlusPlayer *self = reinterpret_cast<PlusPlayer *>(user_data);
+
+  self->telemetry_.OnFirstFrame();
+}
@@ -50,6 +50,9 @@ class PlusPlayer : public VideoPlayer {
   bool SetDisplay();
   bool SetDrm(const std::string &uri, int drm_type,
               const std::string &license_server_url);
+  bool BuildTrackCatalog(TrackCatalog &catalog) override;
+  void SetBufferConfigs(const flutter::EncodableMap &buffer_configs);
+  flutter::EncodableMap GetBufferConfigs() override;
   void RegisterListener();
   static bool OnLicenseAcquired(int *drm_handle, unsigned int length,
                                 unsigned char *pssh_data, void *user_data);
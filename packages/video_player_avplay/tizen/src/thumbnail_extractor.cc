@@ -0,0 +1,454 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "thumbnail_extractor.h"
+
+#include <Ecore.h>
+#include <app_common.h>
+#include <dirent.h>
+#include <image_util.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "log.h"
+
+// Older requests are dropped when scrubbing produces more than this many.
+static constexpr size_t kMaxPendingRequests = 16;
+static constexpr size_t kMaxMemoryCacheSize = 8 * 1024 * 1024;
+static constexpr size_t kMaxDiskCacheEntries = 256;
+static constexpr int kJpegQuality = 80;
+
+static int32_t GetMetadataInt(metadata_extractor_h extractor,
+                              metadata_extractor_attr_e attribute) {
+  char *value = nullptr;
+  int ret = metadata_extractor_get_metadata(extractor, attribute, &value);
+  if (ret != METADATA_EXTRACTOR_ERROR_NONE || !value) {
+    return 0;
+  }
+  int32_t result = std::atoi(value);
+  free(value);
+  return result;
+}
+
+// Returns the largest even size that fits in the given bounds while keeping
+// the aspect ratio. A bound of 0 means unbounded.
+static std::pair<uint32_t, uint32_t> GetScaledSize(uint32_t width,
+                                                   uint32_t height,
+                                                   int32_t max_width,
+                                                   int32_t max_height) {
+  double scale = 1.0;
+  if (max_width > 0 && width > static_cast<uint32_t>(max_width)) {
+    scale = std::min(scale, static_cast<double>(max_width) / width);
+  }
+  if (max_height > 0 && height > static_cast<uint32_t>(max_height)) {
+    scale = std::min(scale, static_cast<double>(max_height) / height);
+  }
+  uint32_t scaled_width = std::max<uint32_t>(2, width * scale) & ~1u;
+  uint32_t scaled_height = std::max<uint32_t>(2, height * scale) & ~1u;
+  return std::make_pair(scaled_width, scaled_height);
+}
+
+ThumbnailExtractor::ThumbnailExtractor() {
+  char *cache_path = app_get_cache_path();
+  if (cache_path) {
+    disk_cache_dir_ = std::string(cache_path) + "video_thumbnails/";
+    free(cache_path);
+    if (mkdir(disk_cache_dir_.c_str(), 0700) != 0 && errno != EEXIST) {
+      LOG_ERROR("[ThumbnailExtractor] Fail to create the cache directory.");
+      disk_cache_dir_.clear();
+    }
+  }
+  worker_ = std::thread(&ThumbnailExtractor::Run, this);
+}
+
+ThumbnailExtractor::~ThumbnailExtractor() {
+  std::deque<Request> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+    pending = std::move(requests_);
+    requests_.clear();
+  }
+  condition_.notify_one();
+  worker_.join();
+
+  // This runs on the main thread, so the pending requests can be answered
+  // directly.
+  for (const Request &request : pending) {
+    for (const ThumbnailCallback &callback : request.callbacks) {
+      callback(std::nullopt, "Cancelled");
+    }
+  }
+}
+
+void ThumbnailExtractor::Extract(const std::string &uri, int64_t position,
+                                 int32_t max_width, int32_t max_height,
+                                 ThumbnailCallback callback) {
+  std::ostringstream key;
+  key << uri << '|' << position << '|' << max_width << 'x' << max_height;
+
+  std::vector<ThumbnailCallback> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(
+        requests_.begin(), requests_.end(),
+        [&key](const Request &request) { return request.key == key.str(); });
+    if (iter != requests_.end()) {
+      iter->callbacks.push_back(std::move(callback));
+      return;
+    }
+
+    if (requests_.size() >= kMaxPendingRequests) {
+      dropped = std::move(requests_.front().callbacks);
+      requests_.pop_front();
+    }
+
+    Request request;
+    request.uri = uri;
+    request.position = position;
+    request.max_width = max_width;
+    request.max_height = max_height;
+    request.key = key.str();
+    request.callbacks.push_back(std::move(callback));
+    requests_.push_back(std::move(request));
+  }
+  condition_.notify_one();
+
+  if (!dropped.empty()) {
+    Deliver(std::move(dropped), std::nullopt, "Cancelled");
+  }
+}
+
+void ThumbnailExtractor::Run() {
+  while (true) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock,
+                      [this] { return is_stopped_ || !requests_.empty(); });
+      if (is_stopped_) {
+        break;
+      }
+      request = std::move(requests_.front());
+      requests_.pop_front();
+    }
+
+    std::string error_message;
+    std::optional<std::vector<uint8_t>> thumbnail =
+        Process(request, error_message);
+    Deliver(std::move(request.callbacks), std::move(thumbnail), error_message);
+  }
+  CloseSource();
+}
+
+std::optional<std::vector<uint8_t>> ThumbnailExtractor::Process(
+    const Request &request, std::string &error_message) {
+  std::optional<std::vector<uint8_t>> thumbnail =
+      GetFromMemoryCache(request.key);
+  if (thumbnail) {
+    return thumbnail;
+  }
+
+  thumbnail = GetFromDiskCache(request.key);
+  if (!thumbnail) {
+    thumbnail = DecodeFrame(request, error_message);
+    if (!thumbnail) {
+      return std::nullopt;
+    }
+    PutToDiskCache(request.key, *thumbnail);
+  }
+  PutToMemoryCache(request.key, *thumbnail);
+  return thumbnail;
+}
+
+bool ThumbnailExtractor::OpenSource(const std::string &uri,
+                                    std::string &error_message) {
+  if (extractor_ && source_uri_ == uri) {
+    return true;
+  }
+  CloseSource();
+
+  int ret = metadata_extractor_create(&extractor_);
+  if (ret != METADATA_EXTRACTOR_ERROR_NONE) {
+    error_message = get_error_message(ret);
+    LOG_ERROR("[ThumbnailExtractor] metadata_extractor_create failed: %s.",
+              error_message.c_str());
+    extractor_ = nullptr;
+    return false;
+  }
+
+  std::string path = uri;
+  if (path.rfind("file://", 0) == 0) {
+    path = path.substr(7);
+  } else if (path.find("://") != std::string::npos) {
+    // The metadata extractor can't open network streams such as HLS or DASH.
+    error_message = "Thumbnails are only supported for local files.";
+    LOG_ERROR("[ThumbnailExtractor] %s", error_message.c_str());
+    CloseSource();
+    return false;
+  }
+  ret = metadata_extractor_set_path(extractor_, path.c_str());
+  if (ret != METADATA_EXTRACTOR_ERROR_NONE) {
+    error_message = get_error_message(ret);
+    LOG_ERROR("[ThumbnailExtractor] metadata_extractor_set_path failed: %s.",
+              error_message.c_str());
+    CloseSource();
+    return false;
+  }
+
+  source_width_ = GetMetadataInt(extractor_, METADATA_VIDEO_WIDTH);
+  source_height_ = GetMetadataInt(extractor_, METADATA_VIDEO_HEIGHT);
+  if (source_width_ <= 0 || source_height_ <= 0) {
+    error_message = "The source has no video stream.";
+    LOG_ERROR("[ThumbnailExtractor] %s", error_message.c_str());
+    CloseSource();
+    return false;
+  }
+  source_uri_ = uri;
+  return true;
+}
+
+void ThumbnailExtractor::CloseSource() {
+  if (extractor_) {
+    metadata_extractor_destroy(extractor_);
+    extractor_ = nullptr;
+  }
+  source_uri_.clear();
+  source_width_ = 0;
+  source_height_ = 0;
+}
+
+std::optional<std::vector<uint8_t>> ThumbnailExtractor::DecodeFrame(
+    const Request &request, std::string &error_message) {
+  if (!OpenSource(request.uri, error_message)) {
+    return std::nullopt;
+  }
+
+  // Decoding the nearest keyframe instead of the exact frame avoids decoding
+  // the whole group of pictures, which is good enough for seek previews.
+  void *frame = nullptr;
+  int frame_size = 0;
+  int ret = metadata_extractor_get_frame_at_time(
+      extractor_, static_cast<unsigned long>(request.position), false, &frame,
+      &frame_size);
+  if (ret != METADATA_EXTRACTOR_ERROR_NONE || !frame) {
+    error_message = get_error_message(ret);
+    LOG_ERROR(
+        "[ThumbnailExtractor] metadata_extractor_get_frame_at_time failed: "
+        "%s.",
+        error_message.c_str());
+    return std::nullopt;
+  }
+
+  // The frame is in RGB888.
+  image_util_image_h source_image = nullptr;
+  ret = image_util_create_image(
+      source_width_, source_height_, IMAGE_UTIL_COLORSPACE_RGB888,
+      static_cast<unsigned char *>(frame), frame_size, &source_image);
+  free(frame);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    error_message = get_error_message(ret);
+    LOG_ERROR("[ThumbnailExtractor] image_util_create_image failed: %s.",
+              error_message.c_str());
+    return std::nullopt;
+  }
+
+  auto [width, height] = GetScaledSize(source_width_, source_height_,
+                                       request.max_width, request.max_height);
+  image_util_image_h image = source_image;
+  if (width != static_cast<uint32_t>(source_width_) ||
+      height != static_cast<uint32_t>(source_height_)) {
+    transformation_h transform = nullptr;
+    ret = image_util_transform_create(&transform);
+    if (ret == IMAGE_UTIL_ERROR_NONE) {
+      ret = image_util_transform_set_resolution(transform, width, height);
+    }
+    if (ret == IMAGE_UTIL_ERROR_NONE) {
+      ret = image_util_transform_run2(transform, source_image, &image);
+    }
+    if (transform) {
+      image_util_transform_destroy(transform);
+    }
+    image_util_destroy_image(source_image);
+    if (ret != IMAGE_UTIL_ERROR_NONE) {
+      error_message = get_error_message(ret);
+      LOG_ERROR("[ThumbnailExtractor] Fail to scale the frame: %s.",
+                error_message.c_str());
+      return std::nullopt;
+    }
+  }
+
+  image_util_encode_h encoder = nullptr;
+  ret = image_util_encode_create(IMAGE_UTIL_JPEG, &encoder);
+  if (ret != IMAGE_UTIL_ERROR_NONE) {
+    error_message = get_error_message(ret);
+    LOG_ERROR("[ThumbnailExtractor] image_util_encode_create failed: %s.",
+              error_message.c_str());
+    image_util_destroy_image(image);
+    return std::nullopt;
+  }
+  image_util_encode_set_quality(encoder, kJpegQuality);
+
+  unsigned char *buffer = nullptr;
+  size_t buffer_size = 0;
+  ret = image_util_encode_run_to_buffer(encoder, image, &buffer, &buffer_size);
+  image_util_encode_destroy(encoder);
+  image_util_destroy_image(image);
+  if (ret != IMAGE_UTIL_ERROR_NONE || !buffer) {
+    error_message = get_error_message(ret);
+    LOG_ERROR(
+        "[ThumbnailExtractor] image_util_encode_run_to_buffer failed: %s.",
+        error_message.c_str());
+    return std::nullopt;
+  }
+
+  std::vector<uint8_t> thumbnail(buffer, buffer + buffer_size);
+  free(buffer);
+  return thumbnail;
+}
+
+std::optional<std::vector<uint8_t>> ThumbnailExtractor::GetFromMemoryCache(
+    const std::string &key) {
+  auto iter = memory_cache_index_.find(key);
+  if (iter == memory_cache_index_.end()) {
+    return std::nullopt;
+  }
+  // Move the entry to the front (most recently used).
+  memory_cache_.splice(memory_cache_.begin(), memory_cache_, iter->second);
+  return iter->second->second;
+}
+
+void ThumbnailExtractor::PutToMemoryCache(
+    const std::string &key, const std::vector<uint8_t> &thumbnail) {
+  if (thumbnail.size() > kMaxMemoryCacheSize ||
+      memory_cache_index_.count(key) > 0) {
+    return;
+  }
+  while (memory_cache_size_ + thumbnail.size() > kMaxMemoryCacheSize) {
+    memory_cache_size_ -= memory_cache_.back().second.size();
+    memory_cache_index_.erase(memory_cache_.back().first);
+    memory_cache_.pop_back();
+  }
+  memory_cache_.emplace_front(key, thumbnail);
+  memory_cache_index_[key] = memory_cache_.begin();
+  memory_cache_size_ += thumbnail.size();
+}
+
+std::string ThumbnailExtractor::GetDiskCachePath(const std::string &key) {
+  char name[32];
+  snprintf(name, sizeof(name), "%016zx.jpg", std::hash<std::string>{}(key));
+  return disk_cache_dir_ + name;
+}
+
+std::optional<std::vector<uint8_t>> ThumbnailExtractor::GetFromDiskCache(
+    const std::string &key) {
+  if (disk_cache_dir_.empty()) {
+    return std::nullopt;
+  }
+  std::ifstream file(GetDiskCachePath(key), std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  // The file starts with the key, so a hash collision is not mistaken for a
+  // hit.
+  std::string stored_key;
+  if (!std::getline(file, stored_key) || stored_key != key) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> thumbnail((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+  if (thumbnail.empty()) {
+    return std::nullopt;
+  }
+  return thumbnail;
+}
+
+void ThumbnailExtractor::PutToDiskCache(const std::string &key,
+                                        const std::vector<uint8_t> &thumbnail) {
+  if (disk_cache_dir_.empty()) {
+    return;
+  }
+
+  // Scan the directory only once, then keep track of the entries in memory.
+  if (!disk_cache_loaded_) {
+    disk_cache_loaded_ = true;
+    std::vector<std::pair<time_t, std::string>> entries;
+    DIR *dir = opendir(disk_cache_dir_.c_str());
+    if (dir) {
+      while (struct dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+          continue;
+        }
+        std::string path = disk_cache_dir_ + entry->d_name;
+        struct stat file_stat;
+        if (stat(path.c_str(), &file_stat) == 0) {
+          entries.emplace_back(file_stat.st_mtime, path);
+        }
+      }
+      closedir(dir);
+    }
+    std::sort(entries.begin(), entries.end());
+    for (auto &entry : entries) {
+      disk_cache_entries_.push_back(std::move(entry.second));
+    }
+  }
+
+  // Evict the oldest entries to stay within the entry limit.
+  std::string path = GetDiskCachePath(key);
+  auto iter =
+      std::find(disk_cache_entries_.begin(), disk_cache_entries_.end(), path);
+  if (iter != disk_cache_entries_.end()) {
+    disk_cache_entries_.erase(iter);
+  }
+  while (disk_cache_entries_.size() >= kMaxDiskCacheEntries) {
+    std::remove(disk_cache_entries_.front().c_str());
+    disk_cache_entries_.pop_front();
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    LOG_ERROR("[ThumbnailExtractor] Fail to open the cache file.");
+    std::remove(path.c_str());
+    return;
+  }
+  file << key << '\n';
+  file.write(reinterpret_cast<const char *>(thumbnail.data()),
+             thumbnail.size());
+  file.close();
+  if (file.fail()) {
+    // Don't leave a truncated entry behind, e.g. when the disk is full.
+    LOG_ERROR("[ThumbnailExtractor] Fail to write the cache file.");
+    std::remove(path.c_str());
+    return;
+  }
+  disk_cache_entries_.push_back(std::move(path));
+}
+
+void ThumbnailExtractor::Deliver(std::vector<ThumbnailCallback> callbacks,
+                                 std::optional<std::vector<uint8_t>> thumbnail,
+                                 const std::string &error_message) {
+  struct Delivery {
+    std::vector<ThumbnailCallback> callbacks;
+    std::optional<std::vector<uint8_t>> thumbnail;
+    std::string error_message;
+  };
+  auto *delivery = new Delivery{std::move(callbacks), std::move(thumbnail),
+                                error_message};
+  ecore_main_loop_thread_safe_call_async(
+      [](void *data) {
+        auto *delivery = static_cast<Delivery *>(data);
+        for (const ThumbnailCallback &callback : delivery->callbacks) {
+          callback(delivery->thumbnail, delivery->error_message);
+        }
+        delete delivery;
+      },
+      delivery);
+}
@@ -0,0 +1,97 @@
+// Copyright 2023 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_THUMBNAIL_EXTRACTOR_H_
+#define FLUTTER_PLUGIN_THUMBNAIL_EXTRACTOR_H_
+
+#include <metadata_extractor.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Extracts JPEG thumbnails of a video at given positions for seek previews.
+//
+// Frames are decoded on a worker thread from the keyframe nearest to the
+// requested position, downscaled, and cached both in memory and on disk.
+class ThumbnailExtractor {
+ public:
+  // Called on the main thread with the encoded image, or std::nullopt and an
+  // error message on failure.
+  using ThumbnailCallback =
+      std::function<void(std::optional<std::vector<uint8_t>> thumbnail,
+                         const std::string &error_message)>;
+
+  ThumbnailExtractor();
+  ~ThumbnailExtractor();
+
+  ThumbnailExtractor(const ThumbnailExtractor &) = delete;
+  ThumbnailExtractor &operator=(const ThumbnailExtractor &) = delete;
+
+  void Extract(const std::string &uri, int64_t position, int32_t max_width,
+               int32_t max_height, ThumbnailCallback callback);
+
+ private:
+  struct Request {
+    std::string uri;
+    int64_t position = 0;
+    int32_t max_width = 0;
+    int32_t max_height = 0;
+    std::string key;
+    std::vector<ThumbnailCallback> callbacks;
+  };
+
+  void Run();
+  std::optional<std::vector<uint8_t>> Process(const Request &request,
+                                              std::string &error_message);
+  bool OpenSource(const std::string &uri, std::string &error_message);
+  void CloseSource();
+  std::optional<std::vector<uint8_t>> DecodeFrame(const Request &request,
+                                                  std::string &error_message);
+
+  std::optional<std::vector<uint8_t>> GetFromMemoryCache(
+      const std::string &key);
+  void PutToMemoryCache(const std::string &key,
+                        const std::vector<uint8_t> &thumbnail);
+  std::optional<std::vector<uint8_t>> GetFromDiskCache(const std::string &key);
+  void PutToDiskCache(const std::string &key,
+                      const std::vector<uint8_t> &thumbnail);
+  std::string GetDiskCachePath(const std::string &key);
+
+  static void Deliver(std::vector<ThumbnailCallback> callbacks,
+                      std::optional<std::vector<uint8_t>> thumbnail,
+                      const std::string &error_message);
+
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<Request> requests_;
+  bool is_stopped_ = false;
+
+  // The following members are only accessed on the worker thread.
+  metadata_extractor_h extractor_ = nullptr;
+  std::string source_uri_;
+  int32_t source_width_ = 0;
+  int32_t source_height_ = 0;
+
+  std::list<std::pair<std::string, std::vector<uint8_t>>> memory_cache_;
+  std::unordered_map<std::string, decltype(memory_cache_)::iterator>
+      memory_cache_index_;
+  size_t memory_cache_size_ = 0;
+  std::string disk_cache_dir_;
+  // The paths of the disk cache files, from the oldest to the newest.
+  std::deque<std::string> disk_cache_entries_;
+  bool disk_cache_loaded_ = false;
+};
+
+#endif  // FLUTTER_PLUGIN_THUMBNAIL_EXTRACTOR_H_
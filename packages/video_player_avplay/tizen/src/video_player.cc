@@ -7,6 +7,7 @@
 #include <flutter/event_stream_handler_functions.h>
 #include <flutter/standard_method_codec.h>
 
+#include "event_dispatcher.h"
 #include "log.h"
 
 static int64_t player_index = 1;
@@ -16,22 +17,16 @@ VideoPlayer::VideoPlayer(flutter::BinaryMessenger *messenger,
     : ecore_wl2_window_proxy_(std::make_unique<EcoreWl2WindowProxy>()),
       binary_messenger_(messenger),
       flutter_view_(flutter_view) {
-  sink_event_pipe_ = ecore_pipe_add(
-      [](void *data, void *buffer, unsigned int nbyte) -> void {
-        auto *self = static_cast<VideoPlayer *>(data);
-        self->ExecuteSinkEvents();
-      },
-      this);
+  EventDispatcher::GetInstance().AddPlayer(this);
 }
 
 VideoPlayer::~VideoPlayer() {
-  if (sink_event_pipe_) {
-    ecore_pipe_del(sink_event_pipe_);
-    sink_event_pipe_ = nullptr;
-  }
+  StopTelemetry();
+  EventDispatcher::GetInstance().RemovePlayer(this);
 }
 
 void VideoPlayer::ClearUpEventChannel() {
+  StopTelemetry();
   is_initialized_ = false;
   event_sink_ = nullptr;
   if (event_channel_) {
@@ -70,32 +65,27 @@ int64_t VideoPlayer::SetUpEventChannel() {
   return player_id;
 }
 
-void VideoPlayer::ExecuteSinkEvents() {
-  std::lock_guard<std::mutex> lock(queue_mutex_);
-  while (!encodable_event_queue_.empty()) {
-    if (event_sink_) {
-      event_sink_->Success(encodable_event_queue_.front());
-    }
-    encodable_event_queue_.pop();
+void VideoPlayer::SinkEvent(const flutter::EncodableValue &event) {
+  if (event_sink_) {
+    event_sink_->Success(event);
   }
+}
 
-  while (!error_event_queue_.empty()) {
-    if (event_sink_) {
-      event_sink_->Error(error_event_queue_.front().first,
-                         error_event_queue_.front().second);
-    }
-    error_event_queue_.pop();
+void VideoPlayer::SinkError(const std::string &error_code,
+                            const std::string &error_message) {
+  if (event_sink_) {
+    event_sink_->Error(error_code, error_message);
   }
 }
 
-void VideoPlayer::PushEvent(flutter::EncodableValue encodable_value) {
-  std::lock_guard<std::mutex> lock(queue_mutex_);
+void VideoPlayer::PushEvent(flutter::EncodableValue &&encodable_value,
+                            bool coalescable) {
   if (event_sink_ == nullptr) {
     LOG_ERROR("[VideoPlayer] event sink is nullptr.");
     return;
   }
-  encodable_event_queue_.push(encodable_value);
-  ecore_pipe_write(sink_event_pipe_, nullptr, 0);
+  EventDispatcher::GetInstance().PostEvent(this, std::move(encodable_value),
+                                           coalescable);
 }
 
 void VideoPlayer::SendInitialized() {
@@ -116,33 +106,44 @@ void VideoPlayer::SendInitialized() {
         {flutter::EncodableValue("width"), flutter::EncodableValue(width)},
         {flutter::EncodableValue("height"), flutter::EncodableValue(height)},
     };
-    PushEvent(flutter::EncodableValue(result));
+    flutter::EncodableMap buffer_configs = GetBufferConfigs();
+    if (!buffer_configs.empty()) {
+      result[flutter::EncodableValue("bufferConfigs")] =
+          flutter::EncodableValue(buffer_configs);
+    }
+    PushEvent(flutter::EncodableValue(std::move(result)));
   }
 }
 
 void VideoPlayer::SendBufferingStart() {
+  telemetry_.OnBufferingStart();
+  telemetry_.OnBufferLevel(0);
   flutter::EncodableMap result = {
       {flutter::EncodableValue("event"),
        flutter::EncodableValue("bufferingStart")},
   };
-  PushEvent(flutter::EncodableValue(result));
+  PushEvent(flutter::EncodableValue(std::move(result)));
 }
 
 void VideoPlayer::SendBufferingUpdate(int32_t value) {
+  telemetry_.OnBufferLevel(value);
   flutter::EncodableMap result = {
       {flutter::EncodableValue("event"),
        flutter::EncodableValue("bufferingUpdate")},
       {flutter::EncodableValue("value"), flutter::EncodableValue(value)},
   };
-  PushEvent(flutter::EncodableValue(result));
+  // Only the latest buffering percentage is of interest.
+  PushEvent(flutter::EncodableValue(std::move(result)), true);
 }
 
 void VideoPlayer::SendBufferingEnd() {
+  telemetry_.OnBufferingEnd();
+  telemetry_.OnBufferLevel(100);
   flutter::EncodableMap result = {
       {flutter::EncodableValue("event"),
        flutter::EncodableValue("bufferingEnd")},
   };
-  PushEvent(flutter::EncodableValue(result));
+  PushEvent(flutter::EncodableValue(std::move(result)));
 }
 
 void VideoPlayer::SendSubtitleUpdate(int32_t duration,
@@ -153,23 +154,112 @@ void VideoPlayer::SendSubtitleUpdate(int32_t duration,
       {flutter::EncodableValue("duration"), flutter::EncodableValue(duration)},
       {flutter::EncodableValue("text"), flutter::EncodableValue(text)},
   };
-  PushEvent(flutter::EncodableValue(result));
+  PushEvent(flutter::EncodableValue(std::move(result)));
 }
 
 void VideoPlayer::SendPlayCompleted() {
   flutter::EncodableMap result = {
       {flutter::EncodableValue("event"), flutter::EncodableValue("completed")},
   };
-  PushEvent(flutter::EncodableValue(result));
+  PushEvent(flutter::EncodableValue(std::move(result)));
 }
 
 void VideoPlayer::SendError(const std::string &error_code,
                             const std::string &error_message) {
   if (event_sink_) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    error_event_queue_.push(std::make_pair(error_code, error_message));
-    ecore_pipe_write(sink_event_pipe_, nullptr, 0);
+    EventDispatcher::GetInstance().PostError(this, error_code, error_message);
+  }
+}
+
+bool VideoPlayer::EnsureTrackCatalog() {
+  if (track_catalog_) {
+    return true;
+  }
+  TrackCatalog catalog;
+  if (!BuildTrackCatalog(catalog)) {
+    return false;
+  }
+  track_catalog_ = std::move(catalog);
+  return true;
+}
+
+flutter::EncodableList VideoPlayer::GetCachedTrackInfo(
+    const std::string &track_type) {
+  std::lock_guard<std::mutex> lock(track_catalog_mutex_);
+  if (!EnsureTrackCatalog()) {
+    return {};
+  }
+  auto iter = track_catalog_->find(track_type);
+  if (iter == track_catalog_->end()) {
+    return {};
+  }
+  return iter->second;
+}
+
+bool VideoPlayer::HasCachedTrack(int32_t track_id,
+                                 const std::string &track_type) {
+  std::lock_guard<std::mutex> lock(track_catalog_mutex_);
+  if (!EnsureTrackCatalog()) {
+    return false;
+  }
+  auto iter = track_catalog_->find(track_type);
+  if (iter == track_catalog_->end()) {
+    return false;
+  }
+  for (const flutter::EncodableValue &track : iter->second) {
+    const auto *track_map = std::get_if<flutter::EncodableMap>(&track);
+    if (track_map && flutter_common::GetValue(track_map, "trackId", -1) ==
+                         track_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void VideoPlayer::RefreshTrackCatalog() {
+  std::lock_guard<std::mutex> lock(track_catalog_mutex_);
+  track_catalog_.reset();
+  EnsureTrackCatalog();
+}
+
+void VideoPlayer::InvalidateTrackCatalog() {
+  std::lock_guard<std::mutex> lock(track_catalog_mutex_);
+  track_catalog_.reset();
+}
+
+void VideoPlayer::StartTelemetry(int32_t interval_ms) {
+  if (interval_ms <= 0) {
+    return;
+  }
+  StopTelemetry();
+  telemetry_timer_ = ecore_timer_add(
+      interval_ms / 1000.0,
+      [](void *data) -> Eina_Bool {
+        auto *self = static_cast<VideoPlayer *>(data);
+        self->SendTelemetry();
+        return ECORE_CALLBACK_RENEW;
+      },
+      this);
+  if (!telemetry_timer_) {
+    LOG_ERROR("[VideoPlayer] Fail to add telemetry timer.");
+  }
+}
+
+void VideoPlayer::StopTelemetry() {
+  if (telemetry_timer_) {
+    ecore_timer_del(telemetry_timer_);
+    telemetry_timer_ = nullptr;
+  }
+}
+
+void VideoPlayer::SendTelemetry() {
+  if (!event_sink_) {
+    return;
   }
+  flutter::EncodableMap result = telemetry_.TakeSummary();
+  result[flutter::EncodableValue("event")] =
+      flutter::EncodableValue("telemetry");
+  PushEvent(flutter::EncodableValue(std::move(result)));
 }
 
 void *VideoPlayer::GetWindowHandle() {
@@ -10,14 +10,16 @@
 #include <flutter/event_channel.h>
 #include <flutter_tizen.h>
 
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <string>
 #include <utility>
 
 #include "ecore_wl2_window_proxy.h"
 #include "messages.h"
+#include "playback_telemetry.h"
 
 class VideoPlayer {
  public:
@@ -54,7 +56,18 @@ class VideoPlayer {
   };
 
  protected:
+  // Track lists keyed by the track type ("video", "audio" or "text").
+  using TrackCatalog = std::map<std::string, flutter::EncodableList>;
+
   virtual void GetVideoSize(int32_t *width, int32_t *height) = 0;
+  // Queries all tracks from the player. Returns false if the tracks are not
+  // available yet.
+  virtual bool BuildTrackCatalog(TrackCatalog &catalog) { return false; }
+  flutter::EncodableList GetCachedTrackInfo(const std::string &track_type);
+  bool HasCachedTrack(int32_t track_id, const std::string &track_type);
+  void RefreshTrackCatalog();
+  void InvalidateTrackCatalog();
+  virtual flutter::EncodableMap GetBufferConfigs() { return {}; }
   void *GetWindowHandle();
   int64_t SetUpEventChannel();
   void ClearUpEventChannel();
@@ -66,23 +79,33 @@ class VideoPlayer {
   void SendPlayCompleted();
   void SendError(const std::string &error_code,
                  const std::string &error_message);
+  void StartTelemetry(int32_t interval_ms);
 
-  std::mutex queue_mutex_;
   std::unique_ptr<EcoreWl2WindowProxy> ecore_wl2_window_proxy_ = nullptr;
   flutter::BinaryMessenger *binary_messenger_;
   bool is_initialized_ = false;
   FlutterDesktopViewRef flutter_view_;
+  PlaybackTelemetry telemetry_;
 
  private:
-  void ExecuteSinkEvents();
-  void PushEvent(flutter::EncodableValue encodable_value);
+  friend class EventDispatcher;
+
+  bool EnsureTrackCatalog();
+
+  void SinkEvent(const flutter::EncodableValue &event);
+  void SinkError(const std::string &error_code,
+                 const std::string &error_message);
+  void PushEvent(flutter::EncodableValue &&encodable_value,
+                 bool coalescable = false);
+  void SendTelemetry();
+  void StopTelemetry();
 
-  std::queue<flutter::EncodableValue> encodable_event_queue_;
-  std::queue<std::pair<std::string, std::string>> error_event_queue_;
   std::unique_ptr<flutter::EventChannel<flutter::EncodableValue>>
       event_channel_;
   std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> event_sink_;
-  Ecore_Pipe *sink_event_pipe_ = nullptr;
+  Ecore_Timer *telemetry_timer_ = nullptr;
+  std::mutex track_catalog_mutex_;
+  std::optional<TrackCatalog> track_catalog_;
 };
 
 namespace flutter_common {
@@ -6,7 +6,9 @@
 
 #include <app_common.h>
 #include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
+#include <flutter/standard_method_codec.h>
 #include <flutter_tizen.h>
 
 #include <cstdint>
@@ -18,10 +20,26 @@
 #include "media_player.h"
 #include "messages.h"
 #include "plus_player.h"
+#include "thumbnail_extractor.h"
 #include "video_player_options.h"
 
 namespace {
 
+// Returns the path of a Flutter asset, or an empty string on failure. Assets
+// of a package are bundled under packages/<package>/.
+std::string GetAssetPath(const std::string &asset, const std::string *package) {
+  char *res_path = app_get_resource_path();
+  if (!res_path) {
+    return std::string();
+  }
+  std::string path = std::string(res_path) + "flutter_assets/";
+  free(res_path);
+  if (package && !package->empty()) {
+    path += "packages/" + *package + "/";
+  }
+  return path + asset;
+}
+
 class VideoPlayerTizenPlugin : public flutter::Plugin,
                                public VideoPlayerAvplayApi {
  public:
@@ -68,10 +86,16 @@ class VideoPlayerTizenPlugin : public flutter::Plugin,
 
  private:
   void DisposeAllPlayers();
+  void HandleThumbnailMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue> &method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
   FlutterDesktopPluginRegistrarRef registrar_ref_;
   flutter::PluginRegistrar *plugin_registrar_;
   VideoPlayerOptions options_;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      thumbnail_channel_;
+  std::unique_ptr<ThumbnailExtractor> thumbnail_extractor_;
 
   static inline std::map<int64_t, std::unique_ptr<VideoPlayer>> players_;
 };
@@ -89,6 +113,15 @@ VideoPlayerTizenPlugin::VideoPlayerTizenPlugin(
     flutter::PluginRegistrar *plugin_registrar)
     : registrar_ref_(registrar_ref), plugin_registrar_(plugin_registrar) {
   VideoPlayerAvplayApi::SetUp(plugin_registrar->messenger(), this);
+
+  thumbnail_channel_ =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          plugin_registrar->messenger(), "tizen/video_player/thumbnail",
+          &flutter::StandardMethodCodec::GetInstance());
+  thumbnail_channel_->SetMethodCallHandler(
+      [this](const auto &call, auto result) {
+        this->HandleThumbnailMethodCall(call, std::move(result));
+      });
 }
 
 VideoPlayerTizenPlugin::~VideoPlayerTizenPlugin() { DisposeAllPlayers(); }
@@ -100,6 +133,70 @@ void VideoPlayerTizenPlugin::DisposeAllPlayers() {
   players_.clear();
 }
 
+void VideoPlayerTizenPlugin::HandleThumbnailMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue> &method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  if (method_call.method_name() != "getThumbnail") {
+    result->NotImplemented();
+    return;
+  }
+  const auto *arguments =
+      std::get_if<flutter::EncodableMap>(method_call.arguments());
+  if (!arguments) {
+    result->Error("Invalid argument", "No arguments provided.");
+    return;
+  }
+
+  std::string uri;
+  std::string asset =
+      flutter_common::GetValue(arguments, "asset", std::string());
+  if (!asset.empty()) {
+    std::string package =
+        flutter_common::GetValue(arguments, "package", std::string());
+    uri = GetAssetPath(asset, &package);
+    if (uri.empty()) {
+      result->Error("Internal error", "Failed to get resource path.");
+      return;
+    }
+  } else {
+    uri = flutter_common::GetValue(arguments, "uri", std::string());
+  }
+  if (uri.empty()) {
+    result->Error("Invalid argument", "Either asset or uri must be set.");
+    return;
+  }
+
+  // Small integers are encoded as int32 by the standard codec.
+  auto get_int = [arguments](const char *key) -> int64_t {
+    auto iter = arguments->find(flutter::EncodableValue(key));
+    if (iter != arguments->end() &&
+        (std::holds_alternative<int32_t>(iter->second) ||
+         std::holds_alternative<int64_t>(iter->second))) {
+      return iter->second.LongValue();
+    }
+    return 0;
+  };
+  int64_t position = get_int("position");
+  int32_t max_width = static_cast<int32_t>(get_int("maxWidth"));
+  int32_t max_height = static_cast<int32_t>(get_int("maxHeight"));
+
+  if (!thumbnail_extractor_) {
+    thumbnail_extractor_ = std::make_unique<ThumbnailExtractor>();
+  }
+  std::shared_ptr<flutter::MethodResult<flutter::EncodableValue>>
+      shared_result = std::move(result);
+  thumbnail_extractor_->Extract(
+      uri, position, max_width, max_height,
+      [shared_result](std::optional<std::vector<uint8_t>> thumbnail,
+                      const std::string &error_message) {
+        if (thumbnail) {
+          shared_result->Success(flutter::EncodableValue(*thumbnail));
+        } else {
+          shared_result->Error("Operation failed", error_message);
+        }
+      });
+}
+
 std::optional<FlutterError> VideoPlayerTizenPlugin::Initialize() {
   DisposeAllPlayers();
   return std::nullopt;
@@ -113,11 +210,8 @@ ErrorOr<PlayerMessage> VideoPlayerTizenPlugin::Create(
   std::string uri;
 
   if (msg.asset() && !msg.asset()->empty()) {
-    char *res_path = app_get_resource_path();
-    if (res_path) {
-      uri = uri + res_path + "flutter_assets/" + *msg.asset();
-      free(res_path);
-    } else {
+    uri = GetAssetPath(*msg.asset(), msg.package_name());
+    if (uri.empty()) {
       return FlutterError("Internal error", "Failed to get resource path.");
     }
   } else if (msg.uri() && !msg.uri()->empty()) {
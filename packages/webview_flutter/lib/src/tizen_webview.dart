@@ -4,6 +4,7 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:flutter/services.dart';
 import 'package:flutter_tizen/widgets.dart';
@@ -28,18 +29,24 @@ class TizenWebView {
 
   final Map<String, JavaScriptChannelParams> _javaScriptChannelParams =
       <String, JavaScriptChannelParams>{};
+  final Map<String, void Function(Uint8List)> _binaryJavaScriptChannels =
+      <String, void Function(Uint8List)>{};
   final Map<String, dynamic> _pendingMethodCalls = <String, dynamic>{};
 
   Future<bool?> _onMethodCall(MethodCall call) async {
     switch (call.method) {
-      case 'javaScriptChannelMessage':
-        final Map<String, Object?> arguments =
-            (call.arguments as Map<Object?, Object?>).cast<String, Object?>();
-        final String channel = arguments['channel']! as String;
-        final String message = arguments['message']! as String;
-        if (_javaScriptChannelParams.containsKey(channel)) {
-          _javaScriptChannelParams[channel]
-              ?.onMessageReceived(JavaScriptMessage(message: message));
+      case 'javaScriptChannelMessages':
+        // Channel names and messages alternate in a flat list.
+        final List<Object?> messages = call.arguments as List<Object?>;
+        for (int i = 0; i + 1 < messages.length; i += 2) {
+          final String channel = messages[i]! as String;
+          final Object? message = messages[i + 1];
+          if (message is Uint8List) {
+            _binaryJavaScriptChannels[channel]?.call(message);
+          } else if (message is String) {
+            _javaScriptChannelParams[channel]
+                ?.onMessageReceived(JavaScriptMessage(message: message));
+          }
         }
 
         return true;
@@ -188,10 +195,26 @@ class TizenWebView {
       JavaScriptChannelParams javaScriptChannelParams) {
     _javaScriptChannelParams[javaScriptChannelParams.name] =
         javaScriptChannelParams;
+    _binaryJavaScriptChannels.remove(javaScriptChannelParams.name);
     return _invokeChannelMethod<void>(
         'addJavaScriptChannel', javaScriptChannelParams.name);
   }
 
+  /// Adds a new JavaScript channel whose messages are delivered as UTF-8
+  /// encoded bytes, so that they can be decoded without an intermediate
+  /// [String], e.g. with `utf8.decoder.fuse(json.decoder)`.
+  ///
+  /// Only string messages are supported. A message is delivered as its UTF-8
+  /// bytes up to the first NUL character, so arbitrary binary data cannot be
+  /// sent through the channel.
+  Future<void> addBinaryJavaScriptChannel(
+      String name, void Function(Uint8List message) onMessageReceived) {
+    _binaryJavaScriptChannels[name] = onMessageReceived;
+    _javaScriptChannelParams.remove(name);
+    return _invokeChannelMethod<void>('addJavaScriptChannel',
+        <String, Object>{'name': name, 'binary': true});
+  }
+
   /// Runs the given JavaScript in the context of the current page.
   Future<void> runJavaScript(String javaScript) =>
       _invokeChannelMethod<void>('runJavaScript', javaScript);
@@ -219,4 +242,36 @@ class TizenWebView {
     final String? result = await _invokeChannelMethod<String?>('getUserAgent');
     return result;
   }
+
+  /// Gets the frame counters of this WebView.
+  Future<TizenWebViewFrameStats> getFrameStats() async {
+    final Map<String, Object?>? stats =
+        (await _invokeChannelMethod<Map<Object?, Object?>>('getFrameStats'))
+            ?.cast<String, Object?>();
+    return TizenWebViewFrameStats(
+      produced: stats?['produced'] as int? ?? 0,
+      consumed: stats?['consumed'] as int? ?? 0,
+      skipped: stats?['skipped'] as int? ?? 0,
+    );
+  }
+}
+
+/// The frame counters of a [TizenWebView].
+class TizenWebViewFrameStats {
+  /// Creates a [TizenWebViewFrameStats].
+  const TizenWebViewFrameStats({
+    required this.produced,
+    required this.consumed,
+    required this.skipped,
+  });
+
+  /// The number of frames rendered by the web engine.
+  final int produced;
+
+  /// The number of frames handed to Flutter.
+  final int consumed;
+
+  /// The number of frames dropped because a newer frame arrived before they
+  /// were shown.
+  final int skipped;
 }
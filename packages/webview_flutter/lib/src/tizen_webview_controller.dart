@@ -29,6 +29,33 @@ extension TizenWebViewControllerExtension on WebViewController {
         platform as TizenWebViewController;
     controller._enginePolicy = enginePolicy;
   }
+
+  /// Gets the numbers of frames produced by the web engine, consumed by
+  /// Flutter, and skipped.
+  Future<TizenWebViewFrameStats> getTizenFrameStats() {
+    final TizenWebViewController controller =
+        platform as TizenWebViewController;
+    return controller._webview.getFrameStats();
+  }
+
+  /// Adds a JavaScript channel whose messages are delivered as UTF-8 encoded
+  /// bytes instead of strings.
+  ///
+  /// Only string messages are supported. A message is delivered as its UTF-8
+  /// bytes up to the first NUL character, so arbitrary binary data cannot be
+  /// sent through the channel.
+  ///
+  /// Messages posted from JavaScript are sent to Dart in batches, once per
+  /// frame.
+  Future<void> addTizenBinaryJavaScriptChannel(
+    String name, {
+    required void Function(Uint8List message) onMessageReceived,
+  }) {
+    final TizenWebViewController controller =
+        platform as TizenWebViewController;
+    return controller._webview
+        .addBinaryJavaScriptChannel(name, onMessageReceived);
+  }
 }
 
 /// An implementation of [PlatformWebViewController] using the Tizen WebView API.
@@ -3,6 +3,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'package:flutter/services.dart';
 import 'package:webview_flutter_platform_interface/webview_flutter_platform_interface.dart';
 
 import 'tizen_webview_controller.dart';
@@ -42,4 +43,13 @@ class TizenWebViewPlatform extends WebViewPlatform {
   static void register() {
     WebViewPlatform.instance = TizenWebViewPlatform();
   }
+
+  /// Keeps [count] web engine instances ready in the background, so that web
+  /// views created later paint sooner.
+  ///
+  /// At most 3 instances are kept. Pass 0 to release the instances.
+  static Future<void> prewarm(int count) {
+    return const MethodChannel('plugins.flutter.io/tizen_webview_pool')
+        .invokeMethod<void>('prewarm', count);
+  }
 }
@@ -3,6 +3,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+export 'src/tizen_webview.dart' show TizenWebViewFrameStats;
 export 'src/tizen_webview_controller.dart';
 export 'src/tizen_webview_cookie_manager.dart';
 export 'src/tizen_webview_platform.dart';
@@ -6,7 +6,18 @@
 
 #include "log.h"
 
-BufferUnit::BufferUnit(int32_t width, int32_t height) { Reset(width, height); }
+BufferUnit::BufferUnit(int32_t width, int32_t height)
+    : width_(width), height_(height) {
+  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
+  gpu_surface_->width = width_;
+  gpu_surface_->height = height_;
+  gpu_surface_->handle = nullptr;
+  gpu_surface_->release_callback = [](void* release_context) {
+    BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
+    buffer->UnmarkInUse();
+  };
+  gpu_surface_->release_context = this;
+}
 
 BufferUnit::~BufferUnit() {
   if (tbm_surface_ && !use_external_buffer_) {
@@ -32,16 +43,15 @@ void BufferUnit::UseExternalBuffer() {
 void BufferUnit::SetExternalBuffer(tbm_surface_h tbm_surface) {
   if (use_external_buffer_) {
     tbm_surface_ = tbm_surface;
+    gpu_surface_->width = tbm_surface_get_width(tbm_surface_);
+    gpu_surface_->height = tbm_surface_get_height(tbm_surface_);
     gpu_surface_->handle = tbm_surface_;
   }
 }
 
 bool BufferUnit::MarkInUse() {
-  if (!is_used_) {
-    is_used_ = true;
-    return true;
-  }
-  return false;
+  bool expected = false;
+  return is_used_.compare_exchange_strong(expected, true);
 }
 
 void BufferUnit::UnmarkInUse() { is_used_ = false; }
@@ -54,38 +64,30 @@ tbm_surface_h BufferUnit::Surface() {
 }
 
 void BufferUnit::Reset(int32_t width, int32_t height) {
-  if (width_ == width && height_ == height) {
+  if (width_ == width && height_ == height && tbm_surface_) {
     return;
   }
   width_ = width;
   height_ = height;
+  if (use_external_buffer_) {
+    // The descriptor takes its size from the surface in SetExternalBuffer(),
+    // so a frame that is still in flight keeps its own size.
+    return;
+  }
 
   if (tbm_surface_) {
     tbm_surface_destroy(tbm_surface_);
-    tbm_surface_ = nullptr;
-  }
-  if (gpu_surface_) {
-    delete gpu_surface_;
-    gpu_surface_ = nullptr;
   }
-
   tbm_surface_ = tbm_surface_create(width_, height_, TBM_FORMAT_ARGB8888);
-  gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
   gpu_surface_->width = width_;
   gpu_surface_->height = height_;
   gpu_surface_->handle = tbm_surface_;
-  gpu_surface_->release_callback = [](void* release_context) {
-    BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
-    buffer->UnmarkInUse();
-  };
-  gpu_surface_->release_context = this;
 }
 
 BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size) {
   for (size_t index = 0; index < pool_size; index++) {
     pool_.emplace_back(std::make_unique<BufferUnit>(width, height));
   }
-  Prepare(width, height);
 }
 
 BufferPool::~BufferPool() {}
@@ -116,6 +118,13 @@ void BufferPool::Prepare(int32_t width, int32_t height) {
   }
 }
 
+void BufferPool::UseExternalBuffers() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t index = 0; index < pool_.size(); index++) {
+    pool_[index]->UseExternalBuffer();
+  }
+}
+
 SingleBufferPool::SingleBufferPool(int32_t width, int32_t height)
     : BufferPool(width, height, 1) {}
 
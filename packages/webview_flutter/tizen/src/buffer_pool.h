@@ -8,6 +8,7 @@
 #include <flutter_texture_registrar.h>
 #include <tbm_surface.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -17,12 +18,14 @@ class BufferUnit {
   explicit BufferUnit(int32_t width, int32_t height);
   ~BufferUnit();
 
+  // Sets the size of the buffer and reallocates its surface if the size has
+  // changed. External surfaces are sized by their owner and never allocated.
   void Reset(int32_t width, int32_t height);
 
   bool MarkInUse();
   void UnmarkInUse();
 
-  bool IsUsed() { return is_used_ && tbm_surface_; }
+  bool IsUsed() { return is_used_.load() && tbm_surface_; }
 
   void UseExternalBuffer();
   void SetExternalBuffer(tbm_surface_h tbm_surface);
@@ -37,7 +40,8 @@ class BufferUnit {
 #endif
 
  private:
-  bool is_used_ = false;
+  // Cleared by the release callback on the raster thread.
+  std::atomic<bool> is_used_ = false;
   bool use_external_buffer_ = false;
   int32_t width_ = 0;
   int32_t height_ = 0;
@@ -55,6 +59,10 @@ class BufferPool {
 
   void Prepare(int32_t with, int32_t height);
 
+  // Makes all buffers wrap surfaces provided by the caller. Must be called
+  // before the first Prepare() so that no surface is allocated.
+  void UseExternalBuffers();
+
  protected:
   std::vector<std::unique_ptr<BufferUnit>> pool_;
 
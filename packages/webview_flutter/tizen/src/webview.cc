@@ -4,20 +4,25 @@
 
 #include "webview.h"
 
-#include <Ecore_Evas.h>
 #include <app_common.h>
 #include <flutter/standard_method_codec.h>
 #include <flutter_texture_registrar.h>
 #include <tbm_surface.h>
 
+#include <cstring>
+
 #include "buffer_pool.h"
 #include "ewk_internal_api_binding.h"
 #include "log.h"
 #include "webview_factory.h"
+#include "webview_pool.h"
 
 namespace {
 
 constexpr size_t kBufferPoolSize = 5;
+// Resizes that follow an applied one within a frame are coalesced into the
+// last one.
+constexpr double kResizeDebounceSec = 1.0 / 60;
 constexpr char kEwkInstance[] = "ewk_instance";
 constexpr char kTizenWebViewChannelName[] = "plugins.flutter.io/tizen_webview_";
 constexpr char kTizenWebViewControllerChannelName[] =
@@ -93,18 +98,23 @@ bool GetValueFromEncodableMap(const flutter::EncodableValue* arguments,
 WebView::WebView(flutter::PluginRegistrar* registrar, int view_id,
                  flutter::TextureRegistrar* texture_registrar, double width,
                  double height, const flutter::EncodableValue& params,
-                 void* window)
+                 void* window, WebViewPool* pool)
     : PlatformView(registrar, view_id, nullptr),
       texture_registrar_(texture_registrar),
       width_(width),
       height_(height),
-      window_(window) {
+      window_(window),
+      pool_(pool) {
   if (!EwkInternalApiBinding::GetInstance().Initialize()) {
     LOG_ERROR("Failed to initialize EWK internal APIs.");
     return;
   }
 
-  tbm_pool_ = std::make_unique<SingleBufferPool>(width, height);
+  // The surfaces are provided by the web engine. The buffers only hold the
+  // descriptors, so that a new frame never overwrites the descriptor that
+  // the Flutter engine is still reading.
+  tbm_pool_ = std::make_unique<BufferPool>(width, height, kBufferPoolSize);
+  tbm_pool_->UseExternalBuffers();
 
   texture_variant_ =
       std::make_unique<flutter::TextureVariant>(flutter::GpuSurfaceTexture(
@@ -173,6 +183,23 @@ std::string WebView::GetNavigationDelegateChannelName() {
 void WebView::Dispose() {
   texture_registrar_->UnregisterTexture(GetTextureId(), nullptr);
 
+  if (resize_timer_) {
+    ecore_timer_del(resize_timer_);
+    resize_timer_ = nullptr;
+  }
+  if (touch_animator_) {
+    ecore_animator_del(touch_animator_);
+    touch_animator_ = nullptr;
+  }
+  if (touch_points_) {
+    eina_list_free(touch_points_);
+    touch_points_ = nullptr;
+  }
+  if (js_message_animator_) {
+    ecore_animator_del(js_message_animator_);
+    js_message_animator_ = nullptr;
+  }
+
   if (webview_instance_) {
     evas_object_smart_callback_del(webview_instance_,
                                    "offscreen,frame,rendered",
@@ -192,8 +219,10 @@ void WebView::Dispose() {
                                    &WebView::OnNavigationPolicy);
     evas_object_smart_callback_del(webview_instance_, "url,changed",
                                    &WebView::OnUrlChange);
-    evas_object_del(webview_instance_);
   }
+  WebViewPool::DestroyInstance({ecore_evas_, webview_instance_});
+  ecore_evas_ = nullptr;
+  webview_instance_ = nullptr;
 
   ewk_shutdown();
 }
@@ -210,6 +239,29 @@ void WebView::Resize(double width, double height) {
   width_ = width;
   height_ = height;
 
+  if (resize_timer_) {
+    has_pending_resize_ = true;
+    return;
+  }
+  // An isolated resize is applied right away. Only the resizes that follow
+  // it within the debounce interval are deferred.
+  ApplyResize();
+  resize_timer_ = ecore_timer_add(
+      kResizeDebounceSec,
+      [](void* data) -> Eina_Bool {
+        WebView* webview = static_cast<WebView*>(data);
+        if (!webview->has_pending_resize_) {
+          webview->resize_timer_ = nullptr;
+          return ECORE_CALLBACK_CANCEL;
+        }
+        webview->has_pending_resize_ = false;
+        webview->ApplyResize();
+        return ECORE_CALLBACK_RENEW;
+      },
+      this);
+}
+
+void WebView::ApplyResize() {
   if (candidate_surface_) {
     candidate_surface_ = nullptr;
   }
@@ -220,14 +272,31 @@ void WebView::Resize(double width, double height) {
 
 void WebView::Touch(int type, int button, double x, double y, double dx,
                     double dy) {
+  if (type == 1) {  // move event
+    pending_move_x_ = x + left_;
+    pending_move_y_ = y + top_;
+    has_pending_move_ = true;
+    if (!touch_animator_) {
+      touch_animator_ = ecore_animator_add(
+          [](void* data) -> Eina_Bool {
+            WebView* webview = static_cast<WebView*>(data);
+            webview->touch_animator_ = nullptr;
+            webview->FlushPendingTouchMove();
+            return ECORE_CALLBACK_CANCEL;
+          },
+          this);
+    }
+    if (!touch_animator_) {
+      FlushPendingTouchMove();
+    }
+    return;
+  }
+
   Ewk_Touch_Event_Type mouse_event_type = EWK_TOUCH_START;
   Evas_Touch_Point_State state = EVAS_TOUCH_POINT_DOWN;
   if (type == 0) {  // down event
     mouse_event_type = EWK_TOUCH_START;
     state = EVAS_TOUCH_POINT_DOWN;
-  } else if (type == 1) {  // move event
-    mouse_event_type = EWK_TOUCH_MOVE;
-    state = EVAS_TOUCH_POINT_MOVE;
   } else if (type == 2) {  // up event
     mouse_event_type = EWK_TOUCH_END;
     state = EVAS_TOUCH_POINT_UP;
@@ -235,17 +304,33 @@ void WebView::Touch(int type, int button, double x, double y, double dx,
     LOG_WARN("Unknown touch event type: %d", type);
   }
 
-  Eina_List* points = 0;
-  Ewk_Touch_Point* point = new Ewk_Touch_Point;
-  point->id = 0;
-  point->x = x + left_;
-  point->y = y + top_;
-  point->state = state;
-  points = eina_list_append(points, point);
+  // Keep the order of events: a pending move precedes this event.
+  FlushPendingTouchMove();
+  FeedTouchEvent(mouse_event_type, state, x + left_, y + top_);
+}
+
+void WebView::FlushPendingTouchMove() {
+  if (!has_pending_move_) {
+    return;
+  }
+  has_pending_move_ = false;
+  FeedTouchEvent(EWK_TOUCH_MOVE, EVAS_TOUCH_POINT_MOVE, pending_move_x_,
+                 pending_move_y_);
+}
+
+void WebView::FeedTouchEvent(Ewk_Touch_Event_Type type,
+                             Evas_Touch_Point_State state, double x,
+                             double y) {
+  if (!touch_points_) {
+    touch_points_ = eina_list_append(touch_points_, &touch_point_);
+  }
+  touch_point_.id = 0;
+  touch_point_.x = x;
+  touch_point_.y = y;
+  touch_point_.state = state;
 
   EwkInternalApiBinding::GetInstance().view.FeedTouchEvent(
-      webview_instance_, mouse_event_type, points, 0);
-  eina_list_free(points);
+      webview_instance_, type, touch_points_, 0);
 }
 
 bool WebView::SendKey(const char* key, const char* string, const char* compose,
@@ -291,47 +376,21 @@ bool WebView::InitWebView() {
     EwkInternalApiBinding::GetInstance().main.SetVersionPolicy(1);
   }
 
-  char* chromium_argv[] = {
-      const_cast<char*>("--disable-pinch"),
-      const_cast<char*>("--js-flags=--expose-gc"),
-      const_cast<char*>("--single-process"),
-      const_cast<char*>("--no-zygote"),
-  };
-  int chromium_argc = sizeof(chromium_argv) / sizeof(chromium_argv[0]);
-  EwkInternalApiBinding::GetInstance().main.SetArguments(chromium_argc,
-                                                         chromium_argv);
-
-  ewk_init();
-  Ecore_Evas* evas = ecore_evas_new("wayland_egl", 0, 0, 1, 1, 0);
-
-  webview_instance_ = ewk_view_add(ecore_evas_get(evas));
-  if (!webview_instance_) {
+  // The prewarmed instances are created with the default engine policy.
+  WebViewInstance instance;
+  if (!engine_policy_ && pool_) {
+    instance = pool_->Take();
+  }
+  if (!instance.view) {
+    instance = WebViewPool::CreateInstance(window_);
+  }
+  if (!instance.view) {
     return false;
   }
-  ecore_evas_focus_set(evas, true);
+  ecore_evas_ = instance.ecore_evas;
+  webview_instance_ = instance.view;
+  ecore_evas_focus_set(ecore_evas_, true);
   ewk_view_focus_set(webview_instance_, true);
-  EwkInternalApiBinding::GetInstance().view.OffscreenRenderingEnabledSet(
-      webview_instance_, true);
-
-  Ewk_Context* context = ewk_view_context_get(webview_instance_);
-  Ewk_Cookie_Manager* cookie_manager = ewk_context_cookie_manager_get(context);
-  if (cookie_manager) {
-    ewk_cookie_manager_accept_policy_set(
-        cookie_manager, EWK_COOKIE_ACCEPT_POLICY_NO_THIRD_PARTY);
-  }
-  ewk_context_cache_model_set(context, EWK_CACHE_MODEL_PRIMARY_WEBBROWSER);
-
-  EwkInternalApiBinding::GetInstance().settings.ImePanelEnabledSet(
-      ewk_view_settings_get(webview_instance_), true);
-  EwkInternalApiBinding::GetInstance().view.ImeWindowSet(webview_instance_,
-                                                         window_);
-  EwkInternalApiBinding::GetInstance().view.KeyEventsEnabledSet(
-      webview_instance_, true);
-
-#ifdef TV_PROFILE
-  EwkInternalApiBinding::GetInstance().view.SupportVideoHoleSet(
-      webview_instance_, window_, true, false);
-#endif
 
   evas_object_smart_callback_add(webview_instance_, "offscreen,frame,rendered",
                                  &WebView::OnFrameRendered, this);
@@ -350,7 +409,7 @@ bool WebView::InitWebView() {
   evas_object_smart_callback_add(webview_instance_, "url,changed",
                                  &WebView::OnUrlChange, this);
 
-  Resize(width_, height_);
+  ApplyResize();
   evas_object_show(webview_instance_);
 
   evas_object_data_set(webview_instance_, kEwkInstance, this);
@@ -480,11 +539,23 @@ void WebView::HandleWebViewMethodCall(const FlMethodCall& method_call,
     }
   } else if (method_name == "addJavaScriptChannel") {
     const auto* channel = std::get_if<std::string>(arguments);
+    std::string name;
+    bool binary = false;
     if (channel) {
+      binary_channels_.erase(*channel);
       RegisterJavaScriptChannelName(*channel);
       result->Success();
+    } else if (GetValueFromEncodableMap(arguments, "name", &name) &&
+               GetValueFromEncodableMap(arguments, "binary", &binary)) {
+      if (binary) {
+        binary_channels_.insert(name);
+      } else {
+        binary_channels_.erase(name);
+      }
+      RegisterJavaScriptChannelName(name);
+      result->Success();
     } else {
-      result->Error("Invalid argument", "The argument must be a string.");
+      result->Error("Invalid argument", "No name or binary provided.");
     }
   } else if (method_name == "clearCache") {
     Ewk_Context* context = ewk_view_context_get(webview_instance_);
@@ -575,6 +646,16 @@ void WebView::HandleWebViewMethodCall(const FlMethodCall& method_call,
   } else if (method_name == "getUserAgent") {
     result->Success(flutter::EncodableValue(
         std::string(ewk_view_user_agent_get(webview_instance_))));
+  } else if (method_name == "getFrameStats") {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flutter::EncodableMap stats = {
+        {flutter::EncodableValue("produced"),
+         flutter::EncodableValue(frames_produced_)},
+        {flutter::EncodableValue("consumed"),
+         flutter::EncodableValue(frames_consumed_)},
+        {flutter::EncodableValue("skipped"),
+         flutter::EncodableValue(frames_skipped_)}};
+    result->Success(flutter::EncodableValue(stats));
   } else {
     result->NotImplemented();
   }
@@ -614,11 +695,13 @@ FlutterDesktopGpuSurfaceDescriptor* WebView::ObtainGpuSurface(size_t width,
     }
     return nullptr;
   }
+  // The previous buffer is normally released by its release callback.
   if (rendered_surface_ && rendered_surface_->IsUsed()) {
     tbm_pool_->Release(rendered_surface_);
   }
   rendered_surface_ = candidate_surface_;
   candidate_surface_ = nullptr;
+  frames_consumed_++;
   return rendered_surface_->GpuSurface();
 }
 
@@ -627,21 +710,33 @@ void WebView::OnFrameRendered(void* data, Evas_Object* obj, void* event_info) {
     WebView* webview = static_cast<WebView*>(data);
 
     std::lock_guard<std::mutex> lock(webview->mutex_);
-    if (!webview->working_surface_) {
-      webview->working_surface_ = webview->tbm_pool_->GetAvailableBuffer();
-      webview->working_surface_->UseExternalBuffer();
+    webview->frames_produced_++;
+
+    BufferUnit* pending = webview->candidate_surface_;
+    BufferUnit* buffer = webview->tbm_pool_->GetAvailableBuffer();
+    if (!buffer) {
+      if (!pending) {
+        // All buffers are in flight and there is nothing to replace.
+        webview->frames_skipped_++;
+        return;
+      }
+      // The pending frame hasn't been handed to Flutter yet, so its buffer
+      // can be reused.
+      buffer = pending;
+    } else if (pending) {
+      webview->tbm_pool_->Release(pending);
+    }
+    if (pending) {
+      // Flutter is behind the engine. Show only the latest frame.
+      webview->frames_skipped_++;
     }
-    webview->working_surface_->SetExternalBuffer(
-        static_cast<tbm_surface_h>(event_info));
 
-    if (webview->candidate_surface_) {
-      webview->tbm_pool_->Release(webview->candidate_surface_);
-      webview->candidate_surface_ = nullptr;
+    buffer->SetExternalBuffer(static_cast<tbm_surface_h>(event_info));
+    webview->candidate_surface_ = buffer;
+    if (!pending) {
+      webview->texture_registrar_->MarkTextureFrameAvailable(
+          webview->GetTextureId());
     }
-    webview->candidate_surface_ = webview->working_surface_;
-    webview->working_surface_ = nullptr;
-    webview->texture_registrar_->MarkTextureFrameAvailable(
-        webview->GetTextureId());
   }
 }
 
@@ -758,17 +853,43 @@ void WebView::OnJavaScriptMessage(Evas_Object* obj,
         static_cast<WebView*>(evas_object_data_get(obj, kEwkInstance));
     if (webview->webview_channel_) {
       std::string channel_name(message.name);
-      std::string message_body(static_cast<char*>(message.body));
-
-      flutter::EncodableMap args = {
-          {flutter::EncodableValue("channel"),
-           flutter::EncodableValue(channel_name)},
-          {flutter::EncodableValue("message"),
-           flutter::EncodableValue(message_body)},
-      };
-      webview->webview_channel_->InvokeMethod(
-          "javaScriptChannelMessage",
-          std::make_unique<flutter::EncodableValue>(args));
+      const char* body = static_cast<char*>(message.body);
+
+      // Messages are queued and sent to Dart once per frame. The body is a
+      // NUL-terminated UTF-8 string, so binary channels carry its bytes only.
+      bool binary = webview->binary_channels_.count(channel_name) > 0;
+      webview->pending_js_messages_.emplace_back(std::move(channel_name));
+      if (binary) {
+        webview->pending_js_messages_.emplace_back(
+            std::vector<uint8_t>(body, body + strlen(body)));
+      } else {
+        webview->pending_js_messages_.emplace_back(std::string(body));
+      }
+
+      if (!webview->js_message_animator_) {
+        webview->js_message_animator_ = ecore_animator_add(
+            [](void* data) -> Eina_Bool {
+              WebView* webview = static_cast<WebView*>(data);
+              webview->js_message_animator_ = nullptr;
+              webview->FlushJavaScriptMessages();
+              return ECORE_CALLBACK_CANCEL;
+            },
+            webview);
+      }
+      if (!webview->js_message_animator_) {
+        webview->FlushJavaScriptMessages();
+      }
     }
   }
 }
+
+void WebView::FlushJavaScriptMessages() {
+  if (pending_js_messages_.empty()) {
+    return;
+  }
+  auto messages = std::make_unique<flutter::EncodableValue>(
+      std::move(pending_js_messages_));
+  pending_js_messages_.clear();
+  webview_channel_->InvokeMethod("javaScriptChannelMessages",
+                                 std::move(messages));
+}
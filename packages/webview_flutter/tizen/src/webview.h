@@ -6,6 +6,8 @@
 #define FLUTTER_PLUGIN_WEBVIEW_H_
 
 #include <EWebKit.h>
+#include <Ecore.h>
+#include <Ecore_Evas.h>
 #include <Evas.h>
 #include <flutter/encodable_value.h>
 #include <flutter/method_channel.h>
@@ -17,20 +19,25 @@
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 
+#include "ewk_internal_api_binding.h"
+
 typedef flutter::MethodCall<flutter::EncodableValue> FlMethodCall;
 typedef flutter::MethodResult<flutter::EncodableValue> FlMethodResult;
 typedef flutter::MethodChannel<flutter::EncodableValue> FlMethodChannel;
 
 class BufferPool;
 class BufferUnit;
+class WebViewPool;
 
 class WebView : public PlatformView {
  public:
   WebView(flutter::PluginRegistrar* registrar, int view_id,
           flutter::TextureRegistrar* texture_registrar, double width,
-          double height, const flutter::EncodableValue& params, void* window);
+          double height, const flutter::EncodableValue& params, void* window,
+          WebViewPool* pool);
   ~WebView();
 
   virtual void Dispose() override;
@@ -63,12 +70,19 @@ class WebView : public PlatformView {
                               std::unique_ptr<FlMethodResult> result);
 
   void RegisterJavaScriptChannelName(const std::string& name);
+  void FlushJavaScriptMessages();
   std::string GetWebViewChannelName();
   std::string GetWebViewControllerChannelName();
   std::string GetNavigationDelegateChannelName();
 
   bool InitWebView();
 
+  void ApplyResize();
+
+  void FeedTouchEvent(Ewk_Touch_Event_Type type, Evas_Touch_Point_State state,
+                      double x, double y);
+  void FlushPendingTouchMove();
+
   static void OnFrameRendered(void* data, Evas_Object* obj, void* event_info);
   static void OnLoadStarted(void* data, Evas_Object* obj, void* event_info);
   static void OnLoadFinished(void* data, Evas_Object* obj, void* event_info);
@@ -82,18 +96,39 @@ class WebView : public PlatformView {
                                    void* user_data);
   static void OnJavaScriptMessage(Evas_Object* obj, Ewk_Script_Message message);
 
+  Ecore_Evas* ecore_evas_ = nullptr;
   Evas_Object* webview_instance_ = nullptr;
   flutter::TextureRegistrar* texture_registrar_;
   bool engine_policy_ = false;
   double width_ = 0.0;
   double height_ = 0.0;
+  Ecore_Timer* resize_timer_ = nullptr;
+  bool has_pending_resize_ = false;
   double left_ = 0.0;
   double top_ = 0.0;
+  // Reused for every touch event fed to the engine.
+  Ewk_Touch_Point touch_point_ = {};
+  Eina_List* touch_points_ = nullptr;
+  // Move events are coalesced and fed once per frame.
+  bool has_pending_move_ = false;
+  double pending_move_x_ = 0.0;
+  double pending_move_y_ = 0.0;
+  Ecore_Animator* touch_animator_ = nullptr;
   void* window_ = nullptr;
-  BufferUnit* working_surface_ = nullptr;
+  WebViewPool* pool_ = nullptr;
   BufferUnit* candidate_surface_ = nullptr;
   BufferUnit* rendered_surface_ = nullptr;
+  // Frames rendered by the engine, handed to Flutter, and dropped because a
+  // newer frame arrived first or all buffers were in flight.
+  int64_t frames_produced_ = 0;
+  int64_t frames_consumed_ = 0;
+  int64_t frames_skipped_ = 0;
   bool has_navigation_delegate_ = false;
+  // The channels whose messages are sent to Dart as UTF-8 bytes.
+  std::set<std::string> binary_channels_;
+  // Pairs of channel names and messages waiting to be sent to Dart.
+  flutter::EncodableList pending_js_messages_;
+  Ecore_Animator* js_message_animator_ = nullptr;
   std::unique_ptr<FlMethodChannel> webview_channel_;
   std::unique_ptr<FlMethodChannel> webview_controller_channel_;
   std::unique_ptr<FlMethodChannel> navigation_delegate_channel_;
@@ -7,6 +7,7 @@
 #include <app_common.h>
 #include <flutter/encodable_value.h>
 #include <flutter/message_codec.h>
+#include <flutter/standard_method_codec.h>
 
 #include <string>
 #include <variant>
@@ -14,16 +15,48 @@
 #include "log.h"
 #include "webview.h"
 
+namespace {
+
+constexpr char kTizenWebViewPoolChannelName[] =
+    "plugins.flutter.io/tizen_webview_pool";
+
+}  // namespace
+
 WebViewFactory::WebViewFactory(flutter::PluginRegistrar* registrar,
                                void* window)
     : PlatformViewFactory(registrar), window_(window) {
   texture_registrar_ = registrar->texture_registrar();
+  pool_ = std::make_unique<WebViewPool>(window_);
+
+  pool_channel_ =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          registrar->messenger(), kTizenWebViewPoolChannelName,
+          &flutter::StandardMethodCodec::GetInstance());
+  pool_channel_->SetMethodCallHandler([this](const auto& call, auto result) {
+    if (call.method_name() == "prewarm") {
+      const auto* count = std::get_if<int32_t>(call.arguments());
+      if (!count || *count < 0) {
+        result->Error("Invalid argument", "The count must be non-negative.");
+        return;
+      }
+      pool_->SetSize(*count);
+      result->Success();
+    } else {
+      result->NotImplemented();
+    }
+  });
 }
 
 PlatformView* WebViewFactory::Create(int view_id, double width, double height,
                                      const ByteMessage& params) {
   return new WebView(GetPluginRegistrar(), view_id, texture_registrar_, width,
-                     height, *GetCodec().DecodeMessage(params), window_);
+                     height, *GetCodec().DecodeMessage(params), window_,
+                     pool_.get());
 }
 
-void WebViewFactory::Dispose() {}
+void WebViewFactory::Dispose() {
+  if (pool_channel_) {
+    pool_channel_->SetMethodCallHandler(nullptr);
+  }
+  pool_.reset();
+}
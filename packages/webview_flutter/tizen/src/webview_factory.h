@@ -5,12 +5,16 @@
 #ifndef FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 #define FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <memory>
 #include <vector>
 
+#include "webview_pool.h"
+
 class WebViewFactory : public PlatformViewFactory {
  public:
   WebViewFactory(flutter::PluginRegistrar* registrar, void* window);
@@ -23,6 +27,9 @@ class WebViewFactory : public PlatformViewFactory {
  private:
   flutter::TextureRegistrar* texture_registrar_;
   void* window_ = nullptr;
+  std::unique_ptr<WebViewPool> pool_;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      pool_channel_;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
@@ -0,0 +1,140 @@
+// Copyright 2021 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "webview_pool.h"
+
+#include <EWebKit.h>
+
+#include "ewk_internal_api_binding.h"
+#include "log.h"
+
+namespace {
+
+constexpr size_t kMaxPoolSize = 3;
+
+}  // namespace
+
+WebViewPool::WebViewPool(void* window) : window_(window) {}
+
+WebViewPool::~WebViewPool() {
+  if (idler_) {
+    ecore_idler_del(idler_);
+    idler_ = nullptr;
+  }
+  for (const WebViewInstance& instance : instances_) {
+    DestroyInstance(instance);
+    ewk_shutdown();
+  }
+}
+
+void WebViewPool::SetSize(size_t size) {
+  if (size > kMaxPoolSize) {
+    LOG_WARN("The pool size is limited to %zu.", kMaxPoolSize);
+    size = kMaxPoolSize;
+  }
+  size_ = size;
+  while (instances_.size() > size_) {
+    DestroyInstance(instances_.back());
+    ewk_shutdown();
+    instances_.pop_back();
+  }
+  ScheduleFill();
+}
+
+WebViewInstance WebViewPool::Take() {
+  if (instances_.empty()) {
+    return WebViewInstance();
+  }
+  WebViewInstance instance = instances_.back();
+  instances_.pop_back();
+  ScheduleFill();
+  return instance;
+}
+
+void WebViewPool::ScheduleFill() {
+  if (!idler_ && instances_.size() < size_) {
+    idler_ = ecore_idler_add(&WebViewPool::OnIdle, this);
+  }
+}
+
+Eina_Bool WebViewPool::OnIdle(void* data) {
+  WebViewPool* pool = static_cast<WebViewPool*>(data);
+  if (pool->instances_.size() >= pool->size_) {
+    pool->idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+
+  WebViewInstance instance = CreateInstance(pool->window_);
+  if (!instance.view) {
+    LOG_ERROR("Failed to prewarm a web engine instance.");
+    ewk_shutdown();
+    pool->idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  pool->instances_.push_back(instance);
+
+  if (pool->instances_.size() >= pool->size_) {
+    pool->idler_ = nullptr;
+    return ECORE_CALLBACK_CANCEL;
+  }
+  return ECORE_CALLBACK_RENEW;
+}
+
+WebViewInstance WebViewPool::CreateInstance(void* window) {
+  char* chromium_argv[] = {
+      const_cast<char*>("--disable-pinch"),
+      const_cast<char*>("--js-flags=--expose-gc"),
+      const_cast<char*>("--single-process"),
+      const_cast<char*>("--no-zygote"),
+  };
+  int chromium_argc = sizeof(chromium_argv) / sizeof(chromium_argv[0]);
+  EwkInternalApiBinding::GetInstance().main.SetArguments(chromium_argc,
+                                                         chromium_argv);
+
+  ewk_init();
+  WebViewInstance result;
+  result.ecore_evas = ecore_evas_new("wayland_egl", 0, 0, 1, 1, 0);
+  if (!result.ecore_evas) {
+    return WebViewInstance();
+  }
+
+  Evas_Object* instance = ewk_view_add(ecore_evas_get(result.ecore_evas));
+  if (!instance) {
+    ecore_evas_free(result.ecore_evas);
+    return WebViewInstance();
+  }
+  result.view = instance;
+  EwkInternalApiBinding::GetInstance().view.OffscreenRenderingEnabledSet(
+      instance, true);
+
+  Ewk_Context* context = ewk_view_context_get(instance);
+  Ewk_Cookie_Manager* cookie_manager = ewk_context_cookie_manager_get(context);
+  if (cookie_manager) {
+    ewk_cookie_manager_accept_policy_set(
+        cookie_manager, EWK_COOKIE_ACCEPT_POLICY_NO_THIRD_PARTY);
+  }
+  ewk_context_cache_model_set(context, EWK_CACHE_MODEL_PRIMARY_WEBBROWSER);
+
+  EwkInternalApiBinding::GetInstance().settings.ImePanelEnabledSet(
+      ewk_view_settings_get(instance), true);
+  EwkInternalApiBinding::GetInstance().view.ImeWindowSet(instance, window);
+  EwkInternalApiBinding::GetInstance().view.KeyEventsEnabledSet(instance,
+                                                                true);
+
+#ifdef TV_PROFILE
+  EwkInternalApiBinding::GetInstance().view.SupportVideoHoleSet(
+      instance, window, true, false);
+#endif
+
+  return result;
+}
+
+void WebViewPool::DestroyInstance(const WebViewInstance& instance) {
+  if (instance.view) {
+    evas_object_del(instance.view);
+  }
+  if (instance.ecore_evas) {
+    ecore_evas_free(instance.ecore_evas);
+  }
+}
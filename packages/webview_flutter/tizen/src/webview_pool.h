@@ -0,0 +1,57 @@
+// Copyright 2021 Samsung Electronics Co., Ltd. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_PLUGIN_WEBVIEW_POOL_H_
+#define FLUTTER_PLUGIN_WEBVIEW_POOL_H_
+
+#include <Ecore.h>
+#include <Ecore_Evas.h>
+#include <Evas.h>
+
+#include <cstddef>
+#include <vector>
+
+// A web engine instance and the canvas that it was created on.
+struct WebViewInstance {
+  Ecore_Evas* ecore_evas = nullptr;
+  Evas_Object* view = nullptr;
+};
+
+// Keeps configured web engine instances ready, so that a new web view can
+// paint without waiting for the engine to start up.
+//
+// Instances are created on the main loop while it is idle, one at a time.
+class WebViewPool {
+ public:
+  explicit WebViewPool(void* window);
+  ~WebViewPool();
+
+  // Sets the number of instances to keep ready.
+  void SetSize(size_t size);
+
+  // Returns a ready instance, or an instance with a null view if there is
+  // none. The caller owns the instance and must call ewk_shutdown() after
+  // destroying it.
+  WebViewInstance Take();
+
+  // Initializes the web engine and creates a configured instance that does
+  // not have focus. Returns an instance with a null view on failure. The web
+  // engine stays initialized even if this fails.
+  static WebViewInstance CreateInstance(void* window);
+
+  // Deletes the view and frees its canvas.
+  static void DestroyInstance(const WebViewInstance& instance);
+
+ private:
+  void ScheduleFill();
+
+  static Eina_Bool OnIdle(void* data);
+
+  void* window_ = nullptr;
+  size_t size_ = 0;
+  std::vector<WebViewInstance> instances_;
+  Ecore_Idler* idler_ = nullptr;
+};
+
+#endif  // FLUTTER_PLUGIN_WEBVIEW_POOL_H_
@@ -202,4 +202,51 @@ class LweWebView {
     final String? result = await _invokeChannelMethod<String?>('getUserAgent');
     return result;
   }
+
+  /// Sets whether to skip rendered frames that are identical to the last
+  /// published frame.
+  Future<void> setSkipUnchangedFrames(bool skip) =>
+      _invokeChannelMethod<void>('setSkipUnchangedFrames', skip);
+
+  /// Gets the frame counters of this WebView.
+  Future<LweFrameStats> getFrameStats() async {
+    final Map<String, Object?>? stats =
+        (await _invokeChannelMethod<Map<Object?, Object?>>('getFrameStats'))
+            ?.cast<String, Object?>();
+    return LweFrameStats(
+      published: stats?['published'] as int? ?? 0,
+      skipped: stats?['skipped'] as int? ?? 0,
+      bufferPoolSize: stats?['bufferPoolSize'] as int? ?? 0,
+      peakBuffersInFlight: stats?['peakBuffersInFlight'] as int? ?? 0,
+      exhaustedCount: stats?['exhaustedCount'] as int? ?? 0,
+    );
+  }
+}
+
+/// The frame counters of a [LweWebView].
+class LweFrameStats {
+  /// Creates a [LweFrameStats].
+  const LweFrameStats({
+    required this.published,
+    required this.skipped,
+    required this.bufferPoolSize,
+    required this.peakBuffersInFlight,
+    required this.exhaustedCount,
+  });
+
+  /// The number of frames handed to Flutter.
+  final int published;
+
+  /// The number of rendered frames dropped because they were identical to the
+  /// last published frame. See [LweWebView.setSkipUnchangedFrames].
+  final int skipped;
+
+  /// The number of buffers currently allocated by the render buffer pool.
+  final int bufferPoolSize;
+
+  /// The largest number of buffers that have been in use at the same time.
+  final int peakBuffersInFlight;
+
+  /// The number of frames dropped because every buffer was in use.
+  final int exhaustedCount;
 }
@@ -163,6 +163,18 @@ class LweWebViewController extends PlatformWebViewController {
   @override
   Future<String?> getUserAgent() => _webview.getUserAgent();
 
+  /// Sets whether to skip rendered frames that are identical to the last
+  /// published frame.
+  ///
+  /// This saves GPU work for static pages that keep repainting the same
+  /// content, at the cost of hashing each rendered frame on the CPU.
+  /// Disabled by default.
+  Future<void> setSkipUnchangedFrames(bool skip) =>
+      _webview.setSkipUnchangedFrames(skip);
+
+  /// Gets the frame counters of this WebView.
+  Future<LweFrameStats> getFrameStats() => _webview.getFrameStats();
+
   @override
   Future<void> setOnPlatformPermissionRequest(
     void Function(
@@ -3,6 +3,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'package:flutter/services.dart';
 import 'package:webview_flutter_platform_interface/webview_flutter_platform_interface.dart';
 
 import 'lwe_webview_controller.dart';
@@ -42,4 +43,26 @@ class LweWebViewPlatform extends WebViewPlatform {
   static void register() {
     WebViewPlatform.instance = LweWebViewPlatform();
   }
+
+  /// Configures the web engine. Must be called before any WebView is created.
+  ///
+  /// [cacheDirectory] is the directory of the persistent HTTP cache, which
+  /// defaults to the app data directory. If the cache is larger than
+  /// [cacheQuotaBytes] on startup, it is cleared. [cacheMode] is the LWE cache
+  /// mode used by every WebView. Images larger than [imageDownscaleThreshold]
+  /// pixels in either dimension are downscaled when decoded to save memory.
+  static Future<void> configureEngine({
+    String? cacheDirectory,
+    int? cacheQuotaBytes,
+    int? cacheMode,
+    int? imageDownscaleThreshold,
+  }) {
+    return const MethodChannel('plugins.flutter.io/lwe_webview_engine')
+        .invokeMethod<void>('configure', <String, Object?>{
+      'cacheDirectory': cacheDirectory,
+      'cacheQuotaBytes': cacheQuotaBytes,
+      'cacheMode': cacheMode,
+      'imageDownscaleThreshold': imageDownscaleThreshold,
+    });
+  }
 }
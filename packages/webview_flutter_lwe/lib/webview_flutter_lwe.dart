@@ -3,6 +3,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+export 'src/lwe_webview.dart' show LweFrameStats;
 export 'src/lwe_webview_controller.dart';
 export 'src/lwe_webview_cookie_manager.dart';
 export 'src/lwe_webview_platform.dart';
@@ -4,31 +4,36 @@
 
 #include "buffer_pool.h"
 
+#include <algorithm>
+
 #include "log.h"
 
-BufferUnit::BufferUnit(int32_t width, int32_t height) { Reset(width, height); }
+namespace {
 
-BufferUnit::~BufferUnit() {
-  if (tbm_surface_) {
-    tbm_surface_destroy(tbm_surface_);
-    tbm_surface_ = nullptr;
-  }
-  if (gpu_surface_) {
-    delete gpu_surface_;
-    gpu_surface_ = nullptr;
-  }
+// The number of acquisitions over which the in-flight depth is sampled, about
+// two seconds at 60 fps.
+constexpr size_t kSamplingWindow = 120;
+
+}  // namespace
+
+BufferUnit::BufferUnit(BufferPool* pool, size_t index)
+    : pool_(pool), index_(index) {}
+
+BufferUnit::~BufferUnit() { Destroy(); }
+
+bool BufferUnit::MarkInUse() { return Transition(State::kFree, State::kInUse); }
+
+bool BufferUnit::UnmarkInUse() {
+  return Transition(State::kInUse, State::kFree);
 }
 
-bool BufferUnit::MarkInUse() {
-  if (!is_used_) {
-    is_used_ = true;
-    return true;
+bool BufferUnit::Unref() {
+  int32_t refs = refs_.load();
+  while (refs > 0 && !refs_.compare_exchange_weak(refs, refs - 1)) {
   }
-  return false;
+  return refs == 1;
 }
 
-void BufferUnit::UnmarkInUse() { is_used_ = false; }
-
 tbm_surface_h BufferUnit::Surface() {
   if (IsUsed()) {
     return tbm_surface_;
@@ -37,21 +42,13 @@ tbm_surface_h BufferUnit::Surface() {
 }
 
 void BufferUnit::Reset(int32_t width, int32_t height) {
-  if (width_ == width && height_ == height) {
+  if (tbm_surface_ && width_ == width && height_ == height) {
     return;
   }
+  Destroy();
   width_ = width;
   height_ = height;
 
-  if (tbm_surface_) {
-    tbm_surface_destroy(tbm_surface_);
-    tbm_surface_ = nullptr;
-  }
-  if (gpu_surface_) {
-    delete gpu_surface_;
-    gpu_surface_ = nullptr;
-  }
-
   tbm_surface_ = tbm_surface_create(width_, height_, TBM_FORMAT_ARGB8888);
   gpu_surface_ = new FlutterDesktopGpuSurfaceDescriptor();
   gpu_surface_->width = width_;
@@ -59,57 +56,201 @@ void BufferUnit::Reset(int32_t width, int32_t height) {
   gpu_surface_->handle = tbm_surface_;
   gpu_surface_->release_callback = [](void* release_context) {
     BufferUnit* buffer = reinterpret_cast<BufferUnit*>(release_context);
-    buffer->UnmarkInUse();
+    buffer->pool_->Release(buffer);
   };
   gpu_surface_->release_context = this;
 }
 
-BufferPool::BufferPool(int32_t width, int32_t height, size_t pool_size) {
-  for (size_t index = 0; index < pool_size; index++) {
-    pool_.emplace_back(std::make_unique<BufferUnit>(width, height));
+void BufferUnit::Destroy() {
+  if (tbm_surface_) {
+    tbm_surface_destroy(tbm_surface_);
+    tbm_surface_ = nullptr;
+  }
+  if (gpu_surface_) {
+    delete gpu_surface_;
+    gpu_surface_ = nullptr;
   }
-  Prepare(width, height);
+}
+
+BufferPool::BufferPool(int32_t width, int32_t height, size_t min_size,
+                       size_t max_size)
+    : min_size_(min_size),
+      max_size_(std::max(min_size, max_size)),
+      width_(width),
+      height_(height) {
+  for (size_t index = 0; index < max_size_; index++) {
+    pool_.emplace_back(std::make_unique<BufferUnit>(this, index));
+  }
+  for (size_t index = 0; index < min_size_; index++) {
+    BufferUnit* buffer = pool_[index].get();
+    buffer->Reset(width_, height_);
+    buffer->state_ = BufferUnit::State::kFree;
+  }
+  size_ = min_size_;
+  target_size_ = min_size_;
 }
 
 BufferPool::~BufferPool() {}
 
 BufferUnit* BufferPool::GetAvailableBuffer() {
+  BufferUnit* buffer = Claim(BufferUnit::State::kFree, max_size_);
+  if (!buffer) {
+    buffer = Grow();
+  }
+  if (!buffer) {
+    uint64_t count = ++exhausted_count_;
+    // Only logs at powers of two to not flood the log while it persists.
+    if ((count & (count - 1)) == 0) {
+      LOG_WARN("All %zu buffers are in use, dropping a frame (%llu times).",
+               max_size_, static_cast<unsigned long long>(count));
+    }
+    return nullptr;
+  }
+  // Prepare() may have marked the buffer stale while it was being released.
+  Refresh(buffer);
+  buffer->refs_ = 1;
+  last_index_ = buffer->index_;
+
+  size_t in_flight = ++in_flight_;
+  UpdateTargetSize(in_flight);
+  if (size_ > target_size_) {
+    Shrink(buffer->index_);
+  }
+  return buffer;
+}
+
+void BufferPool::Retain(BufferUnit* buffer) { buffer->Ref(); }
+
+void BufferPool::Release(BufferUnit* buffer) {
+  if (!buffer->Unref()) {
+    return;
+  }
+  Refresh(buffer);
+  if (buffer->UnmarkInUse()) {
+    last_released_index_ = buffer->index_;
+    in_flight_--;
+  }
+}
+
+void BufferPool::Prepare(int32_t width, int32_t height) {
   std::lock_guard<std::mutex> lock(mutex_);
+  width_ = width;
+  height_ = height;
   for (size_t index = 0; index < pool_.size(); index++) {
-    size_t current = (index + last_index_) % pool_.size();
+    BufferUnit* buffer = pool_[index].get();
+    if (buffer->Transition(BufferUnit::State::kFree,
+                           BufferUnit::State::kInUse)) {
+      buffer->Reset(width, height);
+      buffer->stale_ = false;
+      buffer->state_ = BufferUnit::State::kFree;
+    } else {
+      // The buffer is either in use, possibly by the engine, or has no
+      // surface.
+      buffer->stale_ = true;
+    }
+  }
+}
+
+BufferPool::Stats BufferPool::GetStats() const {
+  return Stats{size_.load(), max_size_, peak_in_flight_.load(),
+               exhausted_count_.load()};
+}
+
+BufferUnit* BufferPool::Claim(BufferUnit::State from, size_t skip) {
+  size_t start = last_index_.load();
+  for (size_t offset = 1; offset <= pool_.size(); offset++) {
+    size_t current = (start + offset) % pool_.size();
+    if (current == skip) {
+      continue;
+    }
     BufferUnit* buffer = pool_[current].get();
-    if (buffer->MarkInUse()) {
-      last_index_ = current;
+    if (buffer->Transition(from, BufferUnit::State::kInUse)) {
       return buffer;
     }
   }
   return nullptr;
 }
 
-void BufferPool::Release(BufferUnit* buffer) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  buffer->UnmarkInUse();
+BufferUnit* BufferPool::Grow() {
+  BufferUnit* buffer = Claim(BufferUnit::State::kIdle, max_size_);
+  if (!buffer) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer->Reset(width_, height_);
+    buffer->stale_ = false;
+  }
+  size_t size = ++size_;
+  size_t target = target_size_.load();
+  while (target < size && !target_size_.compare_exchange_weak(target, size)) {
+  }
+  LOG_DEBUG("Grew the buffer pool to %zu buffers.", size);
+  return buffer;
 }
 
-void BufferPool::Prepare(int32_t width, int32_t height) {
-  std::lock_guard<std::mutex> lock(mutex_);
+void BufferPool::Shrink(size_t acquired) {
+  size_t released = last_released_index_.load();
   for (size_t index = 0; index < pool_.size(); index++) {
+    if (index == acquired || index == released) {
+      continue;
+    }
     BufferUnit* buffer = pool_[index].get();
-    buffer->Reset(width, height);
+    if (buffer->Transition(BufferUnit::State::kFree,
+                           BufferUnit::State::kInUse)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->Destroy();
+        buffer->stale_ = false;
+      }
+      buffer->state_ = BufferUnit::State::kIdle;
+      size_--;
+      return;
+    }
+  }
+}
+
+void BufferPool::UpdateTargetSize(size_t in_flight) {
+  size_t peak = window_peak_.load();
+  while (peak < in_flight &&
+         !window_peak_.compare_exchange_weak(peak, in_flight)) {
+  }
+  peak = peak_in_flight_.load();
+  while (peak < in_flight &&
+         !peak_in_flight_.compare_exchange_weak(peak, in_flight)) {
+  }
+
+  if (++window_count_ % kSamplingWindow != 0) {
+    return;
+  }
+  // Keeps one spare buffer above the deepest in-flight depth of the window.
+  size_t target = window_peak_.exchange(in_flight) + 1;
+  target_size_ = std::min(std::max(target, min_size_), max_size_);
+}
+
+void BufferPool::Refresh(BufferUnit* buffer) {
+  if (buffer->stale_.exchange(false)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer->Reset(width_, height_);
   }
 }
 
 SingleBufferPool::SingleBufferPool(int32_t width, int32_t height)
-    : BufferPool(width, height, 1) {}
+    : BufferPool(width, height, 1, 1) {}
 
 SingleBufferPool::~SingleBufferPool() {}
 
 BufferUnit* SingleBufferPool::GetAvailableBuffer() {
   BufferUnit* buffer = pool_[0].get();
   buffer->MarkInUse();
+  // The only buffer is never released, so Prepare() always marks it stale
+  // instead of resizing it.
+  Refresh(buffer);
   return buffer;
 }
 
+void SingleBufferPool::Retain(BufferUnit* buffer) {}
+
 void SingleBufferPool::Release(BufferUnit* buffer) {}
 
 #ifndef NDEBUG
@@ -8,21 +8,33 @@
 #include <flutter_texture_registrar.h>
 #include <tbm_surface.h>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <vector>
 
+class BufferPool;
+
 class BufferUnit {
  public:
-  explicit BufferUnit(int32_t width, int32_t height);
+  explicit BufferUnit(BufferPool* pool, size_t index);
   ~BufferUnit();
 
+  // Allocates the surface if it doesn't exist yet or if its size is different
+  // from the given size.
   void Reset(int32_t width, int32_t height);
 
   bool MarkInUse();
-  void UnmarkInUse();
+  // Returns false if the unit was not in use.
+  bool UnmarkInUse();
+
+  // Adds a reference to an in-use unit.
+  void Ref() { refs_++; }
+  // Drops a reference and returns true if it was the last one.
+  bool Unref();
 
-  bool IsUsed() { return is_used_ && tbm_surface_; }
+  bool IsUsed() { return state_.load() == State::kInUse && tbm_surface_; }
 
   tbm_surface_h Surface();
 
@@ -34,29 +46,118 @@ class BufferUnit {
 #endif
 
  private:
-  bool is_used_ = false;
+  friend class BufferPool;
+
+  enum class State {
+    // The unit has no surface.
+    kIdle,
+    // The unit has a surface that is not in use.
+    kFree,
+    // The unit is owned by either LWE or the engine, or is being allocated or
+    // freed by the pool.
+    kInUse,
+  };
+
+  bool Transition(State from, State to) {
+    return state_.compare_exchange_strong(from, to);
+  }
+  void Destroy();
+
+  BufferPool* pool_;
+  size_t index_;
+  std::atomic<State> state_ = State::kIdle;
+  // The number of owners of an in-use unit, i.e. the view and each descriptor
+  // handed to the engine that hasn't been released yet.
+  std::atomic<int32_t> refs_ = 0;
+  // Set when the pool was resized while the unit was in use. The surface is
+  // reallocated once the unit is no longer in use.
+  std::atomic<bool> stale_ = false;
   int32_t width_ = 0;
   int32_t height_ = 0;
   tbm_surface_h tbm_surface_ = nullptr;
   FlutterDesktopGpuSurfaceDescriptor* gpu_surface_ = nullptr;
 };
 
+// A pool of surfaces that LWE renders into and the engine composites.
+//
+// Buffers are acquired on the LWE render thread and released on the raster
+// thread without taking a lock: each unit's ownership is an atomic state that
+// is claimed with a compare-and-swap, scanning round-robin from the last
+// acquired unit so that a buffer the engine has just composited is not
+// immediately rendered into again.
+//
+// An acquired buffer holds one reference. Every descriptor handed to the
+// engine must hold another one, taken with Retain() and dropped by the
+// engine's release callback, so that a late release from the engine never
+// frees a buffer that has been acquired again. A buffer returns to the pool
+// when its last reference is released.
+//
+// The number of units holding a surface adapts to the observed in-flight
+// depth between |min_size| and |max_size|. The pool grows as soon as it runs
+// out of buffers, and shrinks when fewer buffers have been in flight over a
+// sampling window.
 class BufferPool {
  public:
-  explicit BufferPool(int32_t width, int32_t height, size_t pool_size);
+  struct Stats {
+    size_t size;
+    size_t max_size;
+    size_t peak_in_flight;
+    uint64_t exhausted_count;
+  };
+
+  explicit BufferPool(int32_t width, int32_t height, size_t min_size,
+                      size_t max_size);
   virtual ~BufferPool();
 
+  // Returns nullptr and records an exhaustion event if every buffer is in use
+  // and the pool can't grow any more.
   virtual BufferUnit* GetAvailableBuffer();
+  virtual void Retain(BufferUnit* buffer);
   virtual void Release(BufferUnit* buffer);
 
+  // Reallocates the surfaces of free buffers to the given size. Buffers in use
+  // keep their surface until they are released.
   void Prepare(int32_t with, int32_t height);
 
+  Stats GetStats() const;
+
  protected:
+  // Reallocates the surface of an in-use |buffer| if it is stale.
+  void Refresh(BufferUnit* buffer);
+
   std::vector<std::unique_ptr<BufferUnit>> pool_;
 
  private:
-  size_t last_index_ = 0;
+  // Claims the first unit in |from| state, starting after the last acquired
+  // unit and skipping |skip|.
+  BufferUnit* Claim(BufferUnit::State from, size_t skip);
+  // Allocates the surface of a unit without one. Returns nullptr if every unit
+  // already has a surface.
+  BufferUnit* Grow();
+  // Frees the surface of a free unit other than the one acquired or released
+  // last.
+  void Shrink(size_t acquired);
+  // Re-evaluates the target size once per sampling window.
+  void UpdateTargetSize(size_t in_flight);
+
+  size_t min_size_;
+  size_t max_size_;
+
+  std::atomic<size_t> last_index_ = 0;
+  std::atomic<size_t> last_released_index_ = 0;
+  std::atomic<size_t> size_ = 0;
+  std::atomic<size_t> target_size_ = 0;
+  std::atomic<size_t> in_flight_ = 0;
+  std::atomic<size_t> window_peak_ = 0;
+  std::atomic<size_t> window_count_ = 0;
+  std::atomic<size_t> peak_in_flight_ = 0;
+  std::atomic<uint64_t> exhausted_count_ = 0;
+
+  // Guards the surface size, which is only touched on the slow paths
+  // (growing, shrinking, resizing and refreshing stale buffers).
   std::mutex mutex_;
+  int32_t width_;
+  int32_t height_;
 };
 
 class SingleBufferPool : public BufferPool {
@@ -65,6 +166,7 @@ class SingleBufferPool : public BufferPool {
   ~SingleBufferPool();
 
   virtual BufferUnit* GetAvailableBuffer() override;
+  virtual void Retain(BufferUnit* buffer) override;
   virtual void Release(BufferUnit* buffer) override;
 };
 
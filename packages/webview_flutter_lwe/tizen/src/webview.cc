@@ -10,6 +10,7 @@
 #include <system_info.h>
 #include <tbm_surface.h>
 
+#include <cstring>
 #include <stdexcept>
 #include <variant>
 
@@ -21,7 +22,10 @@
 
 namespace {
 
-constexpr size_t kBufferPoolSize = 5;
+// The pool starts with enough buffers for LWE, the pending frame and the frame
+// being composited, and grows on demand.
+constexpr size_t kMinBufferPoolSize = 3;
+constexpr size_t kMaxBufferPoolSize = 8;
 constexpr char kLweWebViewChannelName[] = "plugins.flutter.io/lwe_webview_";
 constexpr char kLweNavigationDelegateChannelName[] =
     "plugins.flutter.io/lwe_webview_navigation_delegate_";
@@ -84,6 +88,36 @@ static bool GetValueFromEncodableMap(const flutter::EncodableValue* arguments,
   return false;
 }
 
+// Computes a 64-bit hash of every row of |surface|, or returns 0 if the
+// surface can't be mapped. Padding bytes beyond the row width are ignored.
+static uint64_t HashSurface(tbm_surface_h surface) {
+  tbm_surface_info_s info;
+  if (tbm_surface_map(surface, TBM_SURF_OPTION_READ, &info) !=
+      TBM_SURFACE_ERROR_NONE) {
+    return 0;
+  }
+  constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+  uint64_t hash = info.width * kMultiplier + info.height;
+  size_t row_size = static_cast<size_t>(info.width) * info.bpp / 8;
+  for (uint32_t y = 0; y < info.height; y++) {
+    const unsigned char* row =
+        info.planes[0].ptr + static_cast<size_t>(y) * info.planes[0].stride;
+    size_t x = 0;
+    for (; x + sizeof(uint64_t) <= row_size; x += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, row + x, sizeof(word));
+      hash = (hash ^ word) * kMultiplier;
+      hash ^= hash >> 29;
+    }
+    for (; x < row_size; x++) {
+      hash = (hash ^ row[x]) * kMultiplier;
+    }
+  }
+  tbm_surface_unmap(surface);
+  // Reserves 0 for "unknown".
+  return hash ? hash : 1;
+}
+
 static bool IsRunningOnEmulator() {
   bool result = false;
   char* value = nullptr;
@@ -102,16 +136,19 @@ static bool IsRunningOnEmulator() {
 
 WebView::WebView(flutter::PluginRegistrar* registrar, int view_id,
                  flutter::TextureRegistrar* texture_registrar, double width,
-                 double height, const flutter::EncodableValue& params)
+                 double height, const flutter::EncodableValue& params,
+                 const WebEngineOptions& engine_options)
     : PlatformView(registrar, view_id, nullptr),
       texture_registrar_(texture_registrar),
       width_(width),
-      height_(height) {
+      height_(height),
+      engine_options_(engine_options) {
   use_sw_backend_ = IsRunningOnEmulator();
   if (use_sw_backend_) {
     tbm_pool_ = std::make_unique<SingleBufferPool>(width, height);
   } else {
-    tbm_pool_ = std::make_unique<BufferPool>(width, height, kBufferPoolSize);
+    tbm_pool_ = std::make_unique<BufferPool>(width, height, kMinBufferPoolSize,
+                                             kMaxBufferPoolSize);
   }
 
   texture_variant_ =
@@ -244,8 +281,13 @@ void WebView::Resize(double width, double height) {
   width_ = width;
   height_ = height;
 
-  if (candidate_surface_) {
-    candidate_surface_ = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (candidate_surface_) {
+      tbm_pool_->Release(candidate_surface_);
+      candidate_surface_ = nullptr;
+    }
+    last_frame_hash_ = 0;
   }
 
   tbm_pool_->Prepare(width_, height_);
@@ -524,7 +566,6 @@ void WebView::InitWebView() {
   float pixel_ratio = 1.0;
 
   auto on_prepare_image = [this]() -> LWE::WebContainer::ExternalImageInfo {
-    std::lock_guard<std::mutex> lock(mutex_);
     LWE::WebContainer::ExternalImageInfo result;
     if (!working_surface_) {
       working_surface_ = tbm_pool_->GetAvailableBuffer();
@@ -538,7 +579,33 @@ void WebView::InitWebView() {
   };
   auto on_flush = [this](LWE::WebContainer* container, bool is_rendered) {
     if (is_rendered) {
+      if (!working_surface_) {
+        return;
+      }
+      bool skip_unchanged_frames;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        skip_unchanged_frames = skip_unchanged_frames_;
+      }
+      // LWE doesn't report damaged regions, so compare the content instead.
+      // The surface is hashed without the lock so that the raster thread
+      // isn't blocked in ObtainGpuSurface.
+      uint64_t hash = 0;
+      if (skip_unchanged_frames) {
+        hash = HashSurface(working_surface_->Surface());
+      }
+
       std::lock_guard<std::mutex> lock(mutex_);
+      if (skip_unchanged_frames_) {
+        if (hash && hash == last_frame_hash_) {
+          tbm_pool_->Release(working_surface_);
+          working_surface_ = nullptr;
+          frames_skipped_++;
+          return;
+        }
+        last_frame_hash_ = hash;
+      }
+      frames_published_++;
       if (candidate_surface_) {
         tbm_pool_->Release(candidate_surface_);
         candidate_surface_ = nullptr;
@@ -554,12 +621,19 @@ void WebView::InitWebView() {
           0, 0, width_, height_, pixel_ratio, "SamsungOneUI", "ko-KR",
           "Asia/Seoul", on_prepare_image, on_flush, use_sw_backend_));
 
-#ifndef TV_PROFILE
   LWE::Settings settings = webview_instance_->GetSettings();
+#ifndef TV_PROFILE
   settings.SetUserAgentString(
       "Mozilla/5.0 (like Gecko/54.0 Firefox/54.0) Mobile");
-  webview_instance_->SetSettings(settings);
 #endif
+  if (engine_options_.cache_mode >= 0) {
+    settings.SetCacheMode(engine_options_.cache_mode);
+  }
+  if (engine_options_.image_downscale_threshold > 0) {
+    settings.SetNeedsDownScaleImageResourceLargerThan(
+        static_cast<uint32_t>(engine_options_.image_downscale_threshold));
+  }
+  webview_instance_->SetSettings(settings);
 }
 
 void WebView::HandleWebViewMethodCall(const FlMethodCall& method_call,
@@ -723,6 +797,33 @@ void WebView::HandleWebViewMethodCall(const FlMethodCall& method_call,
     result->Success(flutter::EncodableValue(settings.GetUserAgentString()));
   } else if (method_name == "setCookie") {
     result->NotImplemented();
+  } else if (method_name == "setSkipUnchangedFrames") {
+    const auto* skip = std::get_if<bool>(arguments);
+    if (skip) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      skip_unchanged_frames_ = *skip;
+      last_frame_hash_ = 0;
+      result->Success();
+    } else {
+      result->Error("Invalid argument", "The argument must be a bool.");
+    }
+  } else if (method_name == "getFrameStats") {
+    BufferPool::Stats pool_stats = tbm_pool_->GetStats();
+    std::lock_guard<std::mutex> lock(mutex_);
+    flutter::EncodableMap stats = {
+        {flutter::EncodableValue("published"),
+         flutter::EncodableValue(frames_published_)},
+        {flutter::EncodableValue("skipped"),
+         flutter::EncodableValue(frames_skipped_)},
+        {flutter::EncodableValue("bufferPoolSize"),
+         flutter::EncodableValue(static_cast<int64_t>(pool_stats.size))},
+        {flutter::EncodableValue("peakBuffersInFlight"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(pool_stats.peak_in_flight))},
+        {flutter::EncodableValue("exhaustedCount"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(pool_stats.exhausted_count))}};
+    result->Success(flutter::EncodableValue(stats));
   } else {
     result->NotImplemented();
   }
@@ -750,16 +851,17 @@ void WebView::HandleCookieMethodCall(const FlMethodCall& method_call,
 FlutterDesktopGpuSurfaceDescriptor* WebView::ObtainGpuSurface(size_t width,
                                                               size_t height) {
   std::lock_guard<std::mutex> lock(mutex_);
-  if (!candidate_surface_) {
+  if (candidate_surface_) {
     if (rendered_surface_) {
-      return rendered_surface_->GpuSurface();
+      tbm_pool_->Release(rendered_surface_);
     }
-    return nullptr;
+    rendered_surface_ = candidate_surface_;
+    candidate_surface_ = nullptr;
   }
-  if (rendered_surface_ && rendered_surface_->IsUsed()) {
-    tbm_pool_->Release(rendered_surface_);
+  if (!rendered_surface_) {
+    return nullptr;
   }
-  rendered_surface_ = candidate_surface_;
-  candidate_surface_ = nullptr;
+  // Released by the engine through the descriptor's release callback.
+  tbm_pool_->Retain(rendered_surface_);
   return rendered_surface_->GpuSurface();
 }
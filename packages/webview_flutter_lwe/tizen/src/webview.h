@@ -13,6 +13,7 @@
 #include <flutter_platform_view.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,11 +29,28 @@ class WebContainer;
 class BufferPool;
 class BufferUnit;
 
+// The engine options configured by the app before the first WebView is
+// created.
+struct WebEngineOptions {
+  // The directory of the persistent HTTP cache, or empty for the app data
+  // directory.
+  std::string cache_directory;
+  // The cache is cleared on startup if it's larger than this, or 0 for no
+  // limit.
+  int64_t cache_quota_bytes = 0;
+  // The LWE cache mode of every WebView, or -1 for the engine default.
+  int32_t cache_mode = -1;
+  // Images larger than this dimension are downscaled when decoded to save
+  // memory, or 0 for the engine default.
+  int64_t image_downscale_threshold = 0;
+};
+
 class WebView : public PlatformView {
  public:
   WebView(flutter::PluginRegistrar* registrar, int view_id,
           flutter::TextureRegistrar* texture_registrar, double width,
-          double height, const flutter::EncodableValue& params);
+          double height, const flutter::EncodableValue& params,
+          const WebEngineOptions& engine_options);
   ~WebView();
 
   virtual void Dispose() override;
@@ -69,6 +87,7 @@ class WebView : public PlatformView {
   flutter::TextureRegistrar* texture_registrar_;
   double width_;
   double height_;
+  // Only accessed on the LWE render thread.
   BufferUnit* working_surface_ = nullptr;
   BufferUnit* candidate_surface_ = nullptr;
   BufferUnit* rendered_surface_ = nullptr;
@@ -79,7 +98,13 @@ class WebView : public PlatformView {
   std::unique_ptr<flutter::TextureVariant> texture_variant_;
   std::mutex mutex_;
   std::unique_ptr<BufferPool> tbm_pool_;
+  // Whether to drop rendered frames identical to the last published frame.
+  bool skip_unchanged_frames_ = false;
+  uint64_t last_frame_hash_ = 0;
+  int64_t frames_published_ = 0;
+  int64_t frames_skipped_ = 0;
   bool use_sw_backend_;
+  WebEngineOptions engine_options_;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_H_
@@ -7,15 +7,21 @@
 #include <app_common.h>
 #include <flutter/encodable_value.h>
 #include <flutter/message_codec.h>
+#include <flutter/standard_method_codec.h>
 
+#include <filesystem>
 #include <string>
 #include <variant>
 
 #include "log.h"
 #include "lwe/LWEWebView.h"
-#include "webview.h"
 
-static std::string GetAppDataPath() {
+namespace {
+
+constexpr char kLweWebViewEngineChannelName[] =
+    "plugins.flutter.io/lwe_webview_engine";
+
+std::string GetAppDataPath() {
   char* path = app_get_data_path();
   if (!path) {
     return "/tmp/";
@@ -25,23 +31,141 @@ static std::string GetAppDataPath() {
   return result;
 }
 
+template <typename T>
+bool GetValueFromEncodableMap(const flutter::EncodableMap& map,
+                              const char* key, T* out) {
+  auto iter = map.find(flutter::EncodableValue(key));
+  if (iter != map.end() && !iter->second.IsNull()) {
+    if (auto* value = std::get_if<T>(&iter->second)) {
+      *out = *value;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the total size of the files at |path| in bytes.
+uintmax_t GetDiskUsage(const std::string& path) {
+  std::error_code error;
+  if (std::filesystem::is_regular_file(path, error)) {
+    return std::filesystem::file_size(path, error);
+  }
+  uintmax_t size = 0;
+  for (auto iter = std::filesystem::recursive_directory_iterator(path, error);
+       !error && iter != std::filesystem::recursive_directory_iterator();
+       iter.increment(error)) {
+    if (iter->is_regular_file(error)) {
+      size += iter->file_size(error);
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
 WebViewFactory::WebViewFactory(flutter::PluginRegistrar* registrar)
     : PlatformViewFactory(registrar) {
   texture_registrar_ = registrar->texture_registrar();
 
+  engine_channel_ =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          registrar->messenger(), kLweWebViewEngineChannelName,
+          &flutter::StandardMethodCodec::GetInstance());
+  engine_channel_->SetMethodCallHandler([this](const auto& call, auto result) {
+    if (call.method_name() != "configure") {
+      result->NotImplemented();
+      return;
+    }
+    if (engine_initialized_) {
+      result->Error("Invalid operation",
+                    "The engine must be configured before any WebView is "
+                    "created.");
+      return;
+    }
+    const auto* arguments =
+        std::get_if<flutter::EncodableMap>(call.arguments());
+    if (!arguments) {
+      result->Error("Invalid argument", "The argument must be a map.");
+      return;
+    }
+    WebEngineOptions options;
+    GetValueFromEncodableMap(*arguments, "cacheDirectory",
+                             &options.cache_directory);
+    int32_t int_value = 0;
+    if (GetValueFromEncodableMap(*arguments, "cacheQuotaBytes", &int_value)) {
+      options.cache_quota_bytes = int_value;
+    } else {
+      GetValueFromEncodableMap(*arguments, "cacheQuotaBytes",
+                               &options.cache_quota_bytes);
+    }
+    GetValueFromEncodableMap(*arguments, "cacheMode", &options.cache_mode);
+    if (GetValueFromEncodableMap(*arguments, "imageDownscaleThreshold",
+                                 &int_value)) {
+      options.image_downscale_threshold = int_value;
+    }
+    if (options.cache_quota_bytes < 0 ||
+        options.image_downscale_threshold < 0) {
+      result->Error("Invalid argument", "The limits must be non-negative.");
+      return;
+    }
+    engine_options_ = options;
+    result->Success();
+  });
+}
+
+PlatformView* WebViewFactory::Create(int view_id, double width, double height,
+                                     const ByteMessage& params) {
+  EnsureEngineInitialized();
+  return new WebView(GetPluginRegistrar(), view_id, texture_registrar_, width,
+                     height, *GetCodec().DecodeMessage(params),
+                     engine_options_);
+}
+
+void WebViewFactory::Dispose() {
+  if (engine_channel_) {
+    engine_channel_->SetMethodCallHandler(nullptr);
+  }
+  if (engine_initialized_) {
+    LWE::LWE::Finalize();
+    engine_initialized_ = false;
+  }
+}
+
+void WebViewFactory::EnsureEngineInitialized() {
+  if (engine_initialized_) {
+    return;
+  }
+  engine_initialized_ = true;
+
   std::string data_path = GetAppDataPath();
   std::string local_storage_path = data_path + "StarFish_localStorage.db";
   std::string cookie_path = data_path + "StarFish_cookies.db";
   std::string cache_path = data_path + "Starfish_cache.db";
+  if (!engine_options_.cache_directory.empty()) {
+    std::string directory = engine_options_.cache_directory;
+    if (directory.back() != '/') {
+      directory += '/';
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+      LOG_ERROR("Failed to create %s: %s", directory.c_str(),
+                error.message().c_str());
+    }
+    cache_path = directory + "Starfish_cache.db";
+  }
+
+  // LWE has no cache size limit, so an oversized cache is dropped before the
+  // engine opens it.
+  if (engine_options_.cache_quota_bytes > 0) {
+    uintmax_t usage = GetDiskUsage(cache_path);
+    if (usage > static_cast<uintmax_t>(engine_options_.cache_quota_bytes)) {
+      LOG_INFO("Clearing the HTTP cache (%ju bytes) over the quota.", usage);
+      std::error_code error;
+      std::filesystem::remove_all(cache_path, error);
+    }
+  }
 
   LWE::LWE::Initialize(local_storage_path.c_str(), cookie_path.c_str(),
                        cache_path.c_str());
 }
-
-PlatformView* WebViewFactory::Create(int view_id, double width, double height,
-                                     const ByteMessage& params) {
-  return new WebView(GetPluginRegistrar(), view_id, texture_registrar_, width,
-                     height, *GetCodec().DecodeMessage(params));
-}
-
-void WebViewFactory::Dispose() { LWE::LWE::Finalize(); }
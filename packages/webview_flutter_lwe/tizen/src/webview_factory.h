@@ -5,12 +5,16 @@
 #ifndef FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 #define FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_
 
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
 #include <flutter/texture_registrar.h>
 #include <flutter_platform_view.h>
 
+#include <memory>
 #include <vector>
 
+#include "webview.h"
+
 class WebViewFactory : public PlatformViewFactory {
  public:
   WebViewFactory(flutter::PluginRegistrar* registrar);
@@ -21,7 +25,14 @@ class WebViewFactory : public PlatformViewFactory {
   virtual void Dispose() override;
 
  private:
+  // Initializes LWE with |engine_options_| if it's not initialized yet.
+  void EnsureEngineInitialized();
+
   flutter::TextureRegistrar* texture_registrar_;
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      engine_channel_;
+  WebEngineOptions engine_options_;
+  bool engine_initialized_ = false;
 };
 
 #endif  // FLUTTER_PLUGIN_WEBVIEW_FACTORY_H_